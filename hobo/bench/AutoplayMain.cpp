@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "nanaka/main/Nanaka.h"
+
+#include "bench/Autoplayer.h"
+#include "bench/HeadlessApplication.h"
+#include "bench/Simulation.h"
+
+/**
+ * Writes the game as a script for hobo_determinism, so that it can be played
+ * back and kept as part of the determinism corpus.
+ */
+static bool WriteScript(
+	const std::string& filePath,
+	unsigned int seed,
+	float angle,
+	float strength,
+	const AutoplayResult& result)
+{
+	FILE* file = fopen(filePath.c_str(), "w");
+	if (!file)
+	{
+		fprintf(stderr, "could not write %s\n", filePath.c_str());
+		return false;
+	}
+
+	fprintf(file, "# Played by hobo_autoplay, reaching %.2f.\n",
+		result.m_distance);
+	fprintf(file, "seed %u\n", seed);
+	fprintf(file, "steps %u\n", result.m_numSteps);
+	fprintf(file, "kickoff 0 %g %g\n", angle, strength);
+	for (auto step : result.m_touchSteps)
+	{
+		fprintf(file, "touch %u\n", step);
+	}
+
+	fclose(file);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int numGames = 10;
+	unsigned int numThreads = std::thread::hardware_concurrency();
+	unsigned int horizon = 600;
+	unsigned int maxDelay = 60;
+	unsigned int delayStep = 5;
+	unsigned int maxSteps = 36000;
+	float angle = 0.785f;
+	float strength = 30.0f;
+	std::string scriptDir;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (i + 1 == argc)
+		{
+			fprintf(stderr, "bad argument %s\n", argv[i]);
+			return 1;
+		}
+		else if (strcmp(argv[i], "--games") == 0)
+		{
+			numGames = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--threads") == 0)
+		{
+			numThreads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--horizon") == 0)
+		{
+			horizon = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--max-delay") == 0)
+		{
+			maxDelay = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--delay-step") == 0)
+		{
+			delayStep = std::max(1, atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--max-steps") == 0)
+		{
+			maxSteps = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--angle") == 0)
+		{
+			angle = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--strength") == 0)
+		{
+			strength = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--script-dir") == 0)
+		{
+			scriptDir = argv[++i];
+		}
+		else
+		{
+			fprintf(stderr, "bad argument %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	HeadlessApplication app;
+	Nanaka nanaka(app);
+	Simulation::RegisterEntityTypes(&nanaka);
+
+	Autoplayer autoplayer(&nanaka, numThreads, horizon, maxDelay, delayStep);
+
+	printf("%-6s %12s %8s %8s %10s %10s %10s\n",
+		"seed", "distance", "steps", "touches", "decisions", "rollouts", "ms");
+
+	float totalDistance = 0.0f;
+	bool success = true;
+
+	for (unsigned int seed = 1; seed <= numGames; ++seed)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const auto result = autoplayer.Play(seed, angle, strength, maxSteps);
+		const std::chrono::duration<double, std::milli> duration =
+			std::chrono::steady_clock::now() - start;
+
+		printf("%-6u %12.2f %8u %8zu %10u %10u %10.0f\n",
+			seed,
+			result.m_distance,
+			result.m_numSteps,
+			result.m_touchSteps.size(),
+			result.m_numDecisions,
+			result.m_numRollouts,
+			duration.count());
+
+		totalDistance += result.m_distance;
+
+		if (!scriptDir.empty())
+		{
+			const std::string filePath =
+				scriptDir + "/autoplay_" + std::to_string(seed) + ".txt";
+			success = WriteScript(filePath, seed, angle, strength, result)
+				&& success;
+		}
+	}
+
+	if (numGames > 0)
+	{
+		printf("mean distance %.2f\n", totalDistance / numGames);
+	}
+
+	return success ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench/Autoplayer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+
+const unsigned int Autoplayer::s_noTouch = UINT_MAX;
+
+Autoplayer::Autoplayer(
+	INanaka* nanaka,
+	unsigned int numThreads,
+	unsigned int horizon,
+	unsigned int maxDelay,
+	unsigned int delayStep)
+	: m_game(nanaka)
+	, m_horizon(horizon)
+{
+	// Spawning entities is left to this thread, the workers only step their
+	// own worlds.
+	for (unsigned int i = 0; i < std::max(1u, numThreads); ++i)
+	{
+		m_workers.push_back(
+			std::unique_ptr<Simulation>(new Simulation(nanaka)));
+	}
+
+	for (unsigned int delay = 0; delay <= maxDelay; delay += delayStep)
+	{
+		m_candidates.push_back(delay);
+	}
+	m_candidates.push_back(s_noTouch);
+
+	m_candidateDistances.resize(m_candidates.size());
+}
+
+AutoplayResult Autoplayer::Play(
+	unsigned int seed,
+	float angle,
+	float strength,
+	unsigned int maxSteps)
+{
+	AutoplayResult result;
+	result.m_numDecisions = 0;
+	result.m_numRollouts = 0;
+
+	m_game.Restart(seed);
+	m_game.KickOff(angle, strength);
+
+	SimulationState state;
+	unsigned int touchStep = s_noTouch;
+	bool windowOpen = false;
+
+	unsigned int step = 0;
+	for (; step < maxSteps && !m_game.IsStopped(); ++step)
+	{
+		if (step == touchStep)
+		{
+			m_game.Touch();
+			result.m_touchSteps.push_back(step);
+			touchStep = s_noTouch;
+		}
+		else if (m_game.CanTouch() && !windowOpen)
+		{
+			// A new opportunity to touch, decide when to take it.
+			windowOpen = true;
+			m_game.SaveState(state);
+
+			const unsigned int delay = Decide(state);
+			++result.m_numDecisions;
+			result.m_numRollouts += m_candidates.size();
+
+			if (delay == 0)
+			{
+				m_game.Touch();
+				result.m_touchSteps.push_back(step);
+			}
+			else if (delay != s_noTouch)
+			{
+				touchStep = step + delay;
+			}
+		}
+
+		if (!m_game.CanTouch() && touchStep == s_noTouch)
+		{
+			windowOpen = false;
+		}
+
+		m_game.Step();
+	}
+
+	result.m_distance = m_game.GetDistance();
+	result.m_numSteps = step;
+	return result;
+}
+
+unsigned int Autoplayer::Decide(const SimulationState& state)
+{
+	std::atomic<size_t> nextCandidate(0);
+
+	auto work = [&](Simulation& simulation)
+	{
+		for (size_t i = nextCandidate++; i < m_candidates.size();
+			i = nextCandidate++)
+		{
+			m_candidateDistances[i] =
+				Rollout(simulation, state, m_candidates[i]);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < m_workers.size(); ++i)
+	{
+		threads.push_back(std::thread(work, std::ref(*m_workers[i])));
+	}
+	work(*m_workers[0]);
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	// The earliest of equally good candidates, not touching comes last.
+	size_t best = 0;
+	for (size_t i = 1; i < m_candidates.size(); ++i)
+	{
+		if (m_candidateDistances[i] > m_candidateDistances[best])
+		{
+			best = i;
+		}
+	}
+
+	return m_candidates[best];
+}
+
+float Autoplayer::Rollout(
+	Simulation& simulation,
+	const SimulationState& state,
+	unsigned int delay) const
+{
+	simulation.RestoreState(state);
+
+	// Touch greedily once the candidate has touched, or once the window it
+	// chose not to touch in has closed.
+	bool greedy = false;
+
+	for (unsigned int step = 0; step < m_horizon; ++step)
+	{
+		if (simulation.IsStopped())
+		{
+			break;
+		}
+
+		if (step == delay)
+		{
+			simulation.Touch();
+			greedy = true;
+		}
+		else if (greedy && simulation.CanTouch())
+		{
+			simulation.Touch();
+		}
+		else if (!greedy && delay == s_noTouch && !simulation.CanTouch())
+		{
+			greedy = true;
+		}
+
+		simulation.Step();
+	}
+
+	return simulation.GetDistance();
+}
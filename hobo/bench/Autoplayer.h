@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_BENCH_AUTOPLAYER_H
+#define HOBO_BENCH_AUTOPLAYER_H
+
+#include <memory>
+#include <vector>
+
+#include "bench/Simulation.h"
+#include "main/SimulationState.h"
+
+class INanaka;
+
+struct AutoplayResult
+{
+	float m_distance;
+	unsigned int m_numSteps;
+	unsigned int m_numDecisions;
+	unsigned int m_numRollouts;
+	std::vector<unsigned int> m_touchSteps;
+};
+
+/**
+ * Plays the game by searching for the best time to touch the screen. Each
+ * time a touch would do something, the game state is saved and every
+ * candidate delay, including not touching at all, is rolled out for a
+ * number of steps. The candidate reaching the furthest is played. Rollouts
+ * touch as soon as they can after the candidate's own touch.
+ *
+ * Candidates are rolled out in parallel, each thread simulating in a world
+ * of its own.
+ */
+class Autoplayer final
+{
+public:
+
+	Autoplayer(
+		INanaka* nanaka,
+		unsigned int numThreads,
+		unsigned int horizon,
+		unsigned int maxDelay,
+		unsigned int delayStep);
+
+	AutoplayResult Play(
+		unsigned int seed,
+		float angle,
+		float strength,
+		unsigned int maxSteps);
+
+private:
+
+	static const unsigned int s_noTouch;
+
+	unsigned int Decide(const SimulationState& state);
+	float Rollout(
+		Simulation& simulation,
+		const SimulationState& state,
+		unsigned int delay) const;
+
+	Simulation m_game;
+	std::vector<std::unique_ptr<Simulation>> m_workers;
+
+	unsigned int m_horizon;
+	std::vector<unsigned int> m_candidates;
+	std::vector<float> m_candidateDistances;
+};
+
+#endif // HOBO_BENCH_AUTOPLAYER_H
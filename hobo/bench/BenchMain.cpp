@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "nanaka/entity/EntitySystem.h"
+#include "nanaka/game/GameEM.h"
+#include "nanaka/gui/RenderTargetPanel.h"
+#include "nanaka/main/Nanaka.h"
+#include "nanaka/main/World.h"
+
+#include "bench/Benchmark.h"
+#include "bench/HeadlessApplication.h"
+#include "main/BillboardET.h"
+#include "main/CameraObject.h"
+#include "main/CameraObjectET.h"
+#include "main/ComboController.h"
+#include "main/EntityTypes.h"
+#include "main/Layer.h"
+#include "main/Player.h"
+#include "main/PlayerET.h"
+#include "main/TimeController.h"
+#include "main/Trigger.h"
+#include "main/TriggerET.h"
+#include "main/TriggerManager.h"
+#include "main/Tunables.h"
+#include "main/ViewCuller.h"
+
+static const unsigned int s_numRuns = 5;
+static const unsigned int s_numOps = 100000;
+
+// A kicked off player is in the air for about two seconds of game time.
+static const unsigned int s_stepsPerKickOff = 60;
+
+static void RunBenchmarks(INanaka* nanaka, Benchmark& benchmark)
+{
+	auto& entitySystem = nanaka->GetEntitySystem();
+	entitySystem.RegisterEntityType<PlayerET>(PlayerEntityType);
+	entitySystem.RegisterEntityType<TriggerET>(TriggerEntityType);
+	entitySystem.RegisterEntityType<BillboardET>(BillboardEntityType);
+	entitySystem.RegisterEntityType<CameraObjectET>(CameraEntityType);
+
+	// Set up the same objects as Game does.
+	auto world = std::make_shared<World>();
+	auto& time = world->GetTime();
+
+	Tunables tunables;
+	TimeController timeController;
+	ComboController comboController(timeController, tunables);
+
+	PlayerEMParams playerParams(comboController, timeController, tunables);
+	auto playerEntity = entitySystem.SpawnEntity(
+		PlayerEntityType, &playerParams, &world->GetEntityTree());
+	auto& player = playerEntity->GetModule<GameEM>()->GetGameObject<Player>();
+
+	auto cameraEntity = entitySystem.SpawnEntity(CameraEntityType, NULL);
+	auto& camera =
+		cameraEntity->GetModule<GameEM>()->GetGameObject<CameraObject>();
+	camera.SetRenderTarget(std::make_shared<RenderTargetPanel>());
+	playerEntity->AttachEntity(cameraEntity);
+
+	TriggerManager triggerManager(nanaka,
+		player, timeController, comboController, tunables, world, false);
+
+	ViewCuller viewCuller;
+	Layer layer(nanaka, camera, viewCuller, world, GrassLayerType);
+
+	TriggerEMParams triggerParams(TriggerTypeBoost30,
+		player, comboController, timeController, tunables, false);
+	auto triggerEntity = entitySystem.SpawnEntity(
+		TriggerEntityType, &triggerParams, &world->GetEntityTree());
+	auto& trigger = triggerEntity->GetModule<GameEM>()->GetGameObject<Trigger>();
+	trigger.Initialize();
+
+	player.Reset(0.0f);
+	triggerManager.Reset(0.0f);
+	comboController.Reset();
+
+	// TriggerManager
+	{
+		triggerManager.KickOff();
+
+		// The common case, the player has not passed the reload position.
+		benchmark.Run("TriggerManager::Update", s_numOps, [&]()
+		{
+			triggerManager.Update(0.0f, true);
+		});
+
+		// Passing exactly one reload position per op, each introducing one
+		// new trigger.
+		float x = 0.0f;
+		benchmark.Run("TriggerManager::IntroduceTrigger", s_numOps, [&]()
+		{
+			x += 10.0f;
+			triggerManager.Update(x, true);
+		});
+
+		triggerManager.Reset(0.0f);
+		comboController.Reset();
+	}
+
+	// ComboController
+	{
+		comboController.TriggerAppeared(TriggerTypeBoost45);
+		comboController.TriggerAppeared(TriggerTypeBoost60);
+		comboController.TriggerAppeared(TriggerTypeBoost45);
+
+		// Every ground hit recomputes the available combos.
+		benchmark.Run("ComboController::UpdateAvailableCombos", s_numOps, [&]()
+		{
+			comboController.GroundHit();
+		});
+
+		comboController.TriggerHit(TriggerTypeBoost30);
+		benchmark.Run("ComboController::TryActivateCombo", s_numOps, [&]()
+		{
+			comboController.TryActivateCombo(&trigger);
+		});
+
+		comboController.Reset();
+	}
+
+	// Layer
+	{
+		float scroll = 0.0f;
+		benchmark.Run("Layer::SetScroll", s_numOps, [&]()
+		{
+			scroll += 0.1f;
+			layer.SetScroll(scroll);
+		});
+
+		benchmark.Run("Layer::UpdateViewSize", s_numOps, [&]()
+		{
+			layer.UpdateViewSize();
+		});
+
+		benchmark.Run("ViewCuller::Cull", s_numOps, [&]()
+		{
+			scroll += 0.1f;
+			layer.SetScroll(scroll);
+			viewCuller.Cull(
+				Vec3f(scroll + 10.0f, 0.0f, 3.5f), Vec2f(20.0f, 7.0f));
+		});
+	}
+
+	// Player
+	{
+		// Kick off again before the player comes to rest, so that every op
+		// moves it one step rather than returning early once stopped.
+		unsigned int step = 0;
+		benchmark.Run("Player::Update", s_numOps, [&]()
+		{
+			if (step++ % s_stepsPerKickOff == 0)
+			{
+				timeController.Reset();
+				player.Reset(0.0f);
+				player.KickOff(0.5f, 20.0f);
+			}
+			timeController.Step();
+			player.Update(time);
+		});
+
+		timeController.Reset();
+		player.Reset(0.0f);
+	}
+
+	// Trigger
+	{
+		// The actions a trigger can take on the player in flight. A stop is
+		// left out, it would end the flight. The player is kicked off again
+		// each round, before repeated slowdowns bring it to rest.
+		const TriggerAction actions[] = {
+			TriggerActionBoost30,
+			TriggerActionBoost45,
+			TriggerActionBoost60,
+			TriggerActionSlow,
+			TriggerActionAngle,
+			TriggerActionBlock,
+		};
+		const size_t numActions = sizeof(actions) / sizeof(actions[0]);
+
+		size_t action = 0;
+		benchmark.Run("Trigger::PerformAction", s_numOps, [&]()
+		{
+			if (action == 0)
+			{
+				player.Reset(0.0f);
+				player.KickOff(0.5f, 20.0f);
+			}
+			trigger.SetAction(actions[action]);
+			trigger.PerformAction();
+			action = (action + 1) % numActions;
+		});
+
+		player.Reset(0.0f);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string baselineFilePath;
+	bool writeBaseline = false;
+	double tolerance = 0.1;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--write-baseline") == 0)
+		{
+			writeBaseline = true;
+		}
+		else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+		{
+			tolerance = atof(argv[++i]);
+		}
+		else
+		{
+			baselineFilePath = argv[i];
+		}
+	}
+
+	HeadlessApplication app;
+	Nanaka nanaka(app);
+
+	Benchmark benchmark(s_numRuns);
+	RunBenchmarks(&nanaka, benchmark);
+
+	benchmark.Report();
+
+	if (baselineFilePath.empty())
+	{
+		return 0;
+	}
+	else if (writeBaseline)
+	{
+		return benchmark.WriteBaseline(baselineFilePath) ? 0 : 1;
+	}
+	else
+	{
+		return benchmark.CompareToBaseline(baselineFilePath, tolerance) ? 0 : 1;
+	}
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench/Benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <utility>
+
+/**
+ * Reads a baseline written by Benchmark::WriteBaseline. The format is a flat
+ * JSON object mapping benchmark names to objects with the fields nsPerOp and
+ * allocsPerOp, so a full JSON parser is not needed.
+ */
+static bool ReadBaseline(
+	const std::string& filePath,
+	std::map<std::string, std::pair<double, double>>& baseline)
+{
+	std::ifstream file(filePath);
+	if (!file)
+	{
+		return false;
+	}
+
+	const std::string json((std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>());
+
+	auto readString = [&json](size_t& pos, std::string& str)
+	{
+		const size_t begin = json.find('"', pos);
+		const size_t end = json.find('"', begin + 1);
+		if (begin == std::string::npos || end == std::string::npos)
+		{
+			return false;
+		}
+		str = json.substr(begin + 1, end - begin - 1);
+		pos = end + 1;
+		return true;
+	};
+
+	auto readNumber = [&json](size_t& pos, double& number)
+	{
+		const size_t colon = json.find(':', pos);
+		if (colon == std::string::npos)
+		{
+			return false;
+		}
+		char* end = NULL;
+		number = strtod(json.c_str() + colon + 1, &end);
+		pos = end - json.c_str();
+		return true;
+	};
+
+	size_t pos = json.find('{');
+	std::string name;
+	while (pos != std::string::npos && readString(pos, name))
+	{
+		const size_t entryEnd = json.find('}', pos);
+		double nsPerOp = 0.0;
+		double allocsPerOp = 0.0;
+		std::string field;
+		while (readString(pos, field) && pos < entryEnd)
+		{
+			double value = 0.0;
+			if (!readNumber(pos, value))
+			{
+				return false;
+			}
+			if (field == "nsPerOp")
+			{
+				nsPerOp = value;
+			}
+			else if (field == "allocsPerOp")
+			{
+				allocsPerOp = value;
+			}
+		}
+		baseline[name] = std::make_pair(nsPerOp, allocsPerOp);
+		pos = entryEnd == std::string::npos ? entryEnd : entryEnd + 1;
+	}
+
+	return true;
+}
+
+void Benchmark::Report() const
+{
+	printf("%-48s %12s %12s\n", "benchmark", "ns/op", "allocs/op");
+	for (const auto& result : m_results)
+	{
+		printf("%-48s %12.2f %12.3f\n", result.m_name.c_str(),
+			result.m_nsPerOp, result.m_allocsPerOp);
+	}
+}
+
+bool Benchmark::WriteBaseline(const std::string& filePath) const
+{
+	FILE* file = fopen(filePath.c_str(), "w");
+	if (!file)
+	{
+		return false;
+	}
+
+	fprintf(file, "{\n");
+	for (size_t i = 0; i < m_results.size(); ++i)
+	{
+		const auto& result = m_results[i];
+		fprintf(file, "  \"%s\": {\"nsPerOp\": %.3f, \"allocsPerOp\": %.3f}%s\n",
+			result.m_name.c_str(), result.m_nsPerOp, result.m_allocsPerOp,
+			i + 1 < m_results.size() ? "," : "");
+	}
+	fprintf(file, "}\n");
+
+	return fclose(file) == 0;
+}
+
+bool Benchmark::CompareToBaseline(
+	const std::string& filePath,
+	double tolerance) const
+{
+	std::map<std::string, std::pair<double, double>> baseline;
+	if (!ReadBaseline(filePath, baseline))
+	{
+		printf("Could not read baseline %s, record one with "
+			"--write-baseline.\n", filePath.c_str());
+		return false;
+	}
+
+	bool success = true;
+
+	printf("%-48s %12s %12s\n", "benchmark", "ns/op", "vs baseline");
+	for (const auto& result : m_results)
+	{
+		auto baselineIt = baseline.find(result.m_name);
+		if (baselineIt == baseline.end())
+		{
+			printf("%-48s %12.2f %12s\n",
+				result.m_name.c_str(), result.m_nsPerOp, "new");
+			continue;
+		}
+
+		const double baselineNsPerOp = baselineIt->second.first;
+		const double baselineAllocsPerOp = baselineIt->second.second;
+
+		const bool slower = baselineNsPerOp > 0.0
+			&& result.m_nsPerOp > baselineNsPerOp * (1.0 + tolerance);
+		const bool allocates =
+			result.m_allocsPerOp > baselineAllocsPerOp + 0.0005;
+
+		// A baseline time of zero only holds the allocations.
+		if (baselineNsPerOp > 0.0)
+		{
+			printf("%-48s %12.2f %+11.1f%%%s%s\n", result.m_name.c_str(),
+				result.m_nsPerOp,
+				(result.m_nsPerOp / baselineNsPerOp - 1.0) * 100.0,
+				slower ? " SLOWER" : "",
+				allocates ? " ALLOCATES" : "");
+		}
+		else
+		{
+			printf("%-48s %12.2f %12s%s\n", result.m_name.c_str(),
+				result.m_nsPerOp, "untimed",
+				allocates ? " ALLOCATES" : "");
+		}
+
+		success = success && !slower && !allocates;
+	}
+
+	return success;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_BENCH_BENCHMARK_H
+#define HOBO_BENCH_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "bench/AllocationCounter.h"
+
+struct BenchmarkResult
+{
+	std::string m_name;
+	double m_nsPerOp;
+	double m_allocsPerOp;
+};
+
+/**
+ * Runs microbenchmarks and compares them against a stored baseline. Each
+ * benchmark is run a number of times and the fastest run is kept, since
+ * anything slower than that is noise from the rest of the system.
+ */
+class Benchmark final
+{
+public:
+
+	Benchmark(unsigned int numRuns);
+
+	template<typename Operation>
+	void Run(const std::string& name, unsigned int numOps, Operation operation);
+
+	void Report() const;
+
+	bool WriteBaseline(const std::string& filePath) const;
+
+	/**
+	 * Returns false if any result regressed from the baseline, either by
+	 * being more than tolerance slower or by allocating more, or if the
+	 * baseline can not be read. Benchmarks with a baseline time of zero are
+	 * only checked for allocations.
+	 */
+	bool CompareToBaseline(const std::string& filePath, double tolerance) const;
+
+private:
+
+	unsigned int m_numRuns;
+
+	std::vector<BenchmarkResult> m_results;
+};
+
+inline Benchmark::Benchmark(unsigned int numRuns)
+	: m_numRuns(numRuns)
+{
+}
+
+template<typename Operation>
+void Benchmark::Run(
+	const std::string& name,
+	unsigned int numOps,
+	Operation operation)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	BenchmarkResult result;
+	result.m_name = name;
+	result.m_nsPerOp = 0.0;
+	result.m_allocsPerOp = 0.0;
+
+	// Warm up caches and let any lazily created state settle.
+	for (unsigned int op = 0; op < numOps / 10; ++op)
+	{
+		operation();
+	}
+
+	for (unsigned int run = 0; run < m_numRuns; ++run)
+	{
+		const size_t allocationsBefore = GetNumAllocations();
+		const auto timeBefore = Clock::now();
+
+		for (unsigned int op = 0; op < numOps; ++op)
+		{
+			operation();
+		}
+
+		const std::chrono::duration<double, std::nano> duration =
+			Clock::now() - timeBefore;
+		const double nsPerOp = duration.count() / numOps;
+		const double allocsPerOp =
+			static_cast<double>(GetNumAllocations() - allocationsBefore)
+				/ numOps;
+
+		if (run == 0 || nsPerOp < result.m_nsPerOp)
+		{
+			result.m_nsPerOp = nsPerOp;
+		}
+		result.m_allocsPerOp = std::max(result.m_allocsPerOp, allocsPerOp);
+	}
+
+	m_results.push_back(result);
+}
+
+#endif // HOBO_BENCH_BENCHMARK_H
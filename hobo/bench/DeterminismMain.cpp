@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nanaka/main/Nanaka.h"
+
+#include "bench/HeadlessApplication.h"
+#include "bench/Simulation.h"
+#include "main/StateHash.h"
+
+enum ScriptAction
+{
+	ScriptActionKickOff,
+	ScriptActionTouch,
+	ScriptActionRestart,
+};
+
+struct ScriptEvent
+{
+	unsigned int m_step;
+	ScriptAction m_action;
+	float m_angle;
+	float m_strength;
+};
+
+/**
+ * A scripted run, read from a text file with one directive per line:
+ *
+ *   seed <n>                          seed of the trigger sequence
+ *   steps <n>                         number of simulation steps to run,
+ *                                     60 per second of real time
+ *   kickoff <step> <angle> <strength> as from the kick off dpad
+ *   touch <step>                      screen touched
+ *   restart <step>                    restart button pushed
+ *
+ * Lines starting with # are comments. Events must be in step order.
+ */
+struct Script
+{
+	unsigned int m_seed;
+	unsigned int m_numSteps;
+	std::vector<ScriptEvent> m_events;
+};
+
+/**
+ * The state hash taken every interval steps, as (step, hash) pairs.
+ */
+typedef std::vector<std::pair<unsigned int, uint64_t>> HashTrace;
+
+static bool ReadScript(const std::string& filePath, Script& script)
+{
+	std::ifstream file(filePath);
+	if (!file)
+	{
+		fprintf(stderr, "could not read script %s\n", filePath.c_str());
+		return false;
+	}
+
+	script.m_seed = 0;
+	script.m_numSteps = 0;
+	script.m_events.clear();
+
+	std::string line;
+	unsigned int lineNum = 0;
+	while (std::getline(file, line))
+	{
+		++lineNum;
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream stream(line);
+		std::string directive;
+		stream >> directive;
+
+		ScriptEvent event = { 0, ScriptActionTouch, 0.0f, 0.0f };
+		if (directive == "seed")
+		{
+			stream >> script.m_seed;
+		}
+		else if (directive == "steps")
+		{
+			stream >> script.m_numSteps;
+		}
+		else if (directive == "kickoff")
+		{
+			event.m_action = ScriptActionKickOff;
+			stream >> event.m_step >> event.m_angle >> event.m_strength;
+			script.m_events.push_back(event);
+		}
+		else if (directive == "touch")
+		{
+			event.m_action = ScriptActionTouch;
+			stream >> event.m_step;
+			script.m_events.push_back(event);
+		}
+		else if (directive == "restart")
+		{
+			event.m_action = ScriptActionRestart;
+			stream >> event.m_step;
+			script.m_events.push_back(event);
+		}
+		else
+		{
+			stream.setstate(std::ios::failbit);
+		}
+
+		if (stream.fail())
+		{
+			fprintf(stderr, "%s:%u: bad line\n", filePath.c_str(), lineNum);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void RunScript(
+	Simulation& simulation,
+	const Script& script,
+	unsigned int interval,
+	HashTrace& trace)
+{
+	simulation.Restart(script.m_seed);
+
+	trace.clear();
+	auto event = script.m_events.begin();
+	for (unsigned int step = 0; step < script.m_numSteps; ++step)
+	{
+		for (; event != script.m_events.end() && event->m_step == step; ++event)
+		{
+			switch (event->m_action)
+			{
+			case ScriptActionKickOff:
+				simulation.KickOff(event->m_angle, event->m_strength);
+				break;
+
+			case ScriptActionTouch:
+				simulation.Touch();
+				break;
+
+			case ScriptActionRestart:
+				simulation.Restart(script.m_seed);
+				break;
+			}
+		}
+
+		simulation.Step();
+
+		if (step % interval == 0 || step + 1 == script.m_numSteps)
+		{
+			StateHash hash;
+			simulation.HashState(hash);
+			trace.push_back(std::make_pair(step, hash.GetValue()));
+		}
+	}
+}
+
+static bool WriteTrace(const std::string& filePath, const HashTrace& trace)
+{
+	FILE* file = fopen(filePath.c_str(), "w");
+	if (!file)
+	{
+		fprintf(stderr, "could not write %s\n", filePath.c_str());
+		return false;
+	}
+
+	for (const auto& entry : trace)
+	{
+		fprintf(file, "%u %016" PRIx64 "\n", entry.first, entry.second);
+	}
+
+	fclose(file);
+	return true;
+}
+
+static bool ReadTrace(const std::string& filePath, HashTrace& trace)
+{
+	FILE* file = fopen(filePath.c_str(), "r");
+	if (!file)
+	{
+		fprintf(stderr, "could not read %s\n", filePath.c_str());
+		return false;
+	}
+
+	trace.clear();
+	unsigned int step;
+	uint64_t hash;
+	while (fscanf(file, "%u %" SCNx64, &step, &hash) == 2)
+	{
+		trace.push_back(std::make_pair(step, hash));
+	}
+
+	fclose(file);
+	return true;
+}
+
+/**
+ * Returns true if the traces are identical, otherwise reports the first step
+ * where they differ. With an interval above one the state may have diverged
+ * anywhere after the last matching step.
+ */
+static bool CompareTraces(
+	const std::string& name,
+	const HashTrace& expected,
+	const HashTrace& actual)
+{
+	const size_t size = std::min(expected.size(), actual.size());
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (expected[i].first != actual[i].first)
+		{
+			printf("%-32s hashed at different steps, %u vs %u\n",
+				name.c_str(), expected[i].first, actual[i].first);
+			return false;
+		}
+
+		if (expected[i].second != actual[i].second)
+		{
+			printf("%-32s DIVERGED at step %u", name.c_str(), actual[i].first);
+			if (i > 0)
+			{
+				printf(", last match at step %u", actual[i - 1].first);
+			}
+			printf("\n");
+			return false;
+		}
+	}
+
+	if (expected.size() != actual.size())
+	{
+		printf("%-32s %zu hashes vs %zu\n",
+			name.c_str(), expected.size(), actual.size());
+		return false;
+	}
+
+	printf("%-32s ok, %zu hashes\n", name.c_str(), actual.size());
+	return true;
+}
+
+static std::string BaseName(const std::string& filePath)
+{
+	const size_t slash = filePath.find_last_of('/');
+	return slash == std::string::npos ? filePath : filePath.substr(slash + 1);
+}
+
+static void PrintUsage()
+{
+	fprintf(stderr,
+		"usage: hobo_determinism [--interval N] [--write-golden] "
+		"GOLDEN_DIR SCRIPT...\n"
+		"       hobo_determinism --diff TRACE TRACE\n");
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int interval = 1;
+	bool writeGolden = false;
+	bool diff = false;
+	std::vector<std::string> paths;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc)
+		{
+			interval = std::max(1, atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--write-golden") == 0)
+		{
+			writeGolden = true;
+		}
+		else if (strcmp(argv[i], "--diff") == 0)
+		{
+			diff = true;
+		}
+		else
+		{
+			paths.push_back(argv[i]);
+		}
+	}
+
+	// Compare the traces of two builds, written with --write-golden.
+	if (diff)
+	{
+		HashTrace first, second;
+		if (paths.size() != 2
+			|| !ReadTrace(paths[0], first)
+			|| !ReadTrace(paths[1], second))
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		return CompareTraces(BaseName(paths[1]), first, second) ? 0 : 1;
+	}
+
+	if (paths.size() < 2)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	HeadlessApplication app;
+	Nanaka nanaka(app);
+
+	Simulation::RegisterEntityTypes(&nanaka);
+
+	const std::string goldenDir = paths[0];
+	bool success = true;
+
+	for (size_t i = 1; i < paths.size(); ++i)
+	{
+		const std::string name = BaseName(paths[i]);
+		const std::string goldenPath = goldenDir + "/" + name;
+
+		Script script;
+		if (!ReadScript(paths[i], script))
+		{
+			success = false;
+			continue;
+		}
+
+		// A fresh simulation per script so that no state carries over.
+		Simulation simulation(&nanaka);
+		HashTrace trace;
+		RunScript(simulation, script, interval, trace);
+
+		if (writeGolden)
+		{
+			success = WriteTrace(goldenPath, trace) && success;
+			continue;
+		}
+
+		// A new script gets its golden written on the first run, to be
+		// committed along with it.
+		if (!std::ifstream(goldenPath))
+		{
+			printf("%-32s new, golden written\n", name.c_str());
+			success = WriteTrace(goldenPath, trace) && success;
+			continue;
+		}
+
+		HashTrace golden;
+		if (!ReadTrace(goldenPath, golden))
+		{
+			success = false;
+			continue;
+		}
+
+		success = CompareTraces(name, golden, trace) && success;
+	}
+
+	return success ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench/Simulation.h"
+
+#include "nanaka/entity/EntitySystem.h"
+#include "nanaka/game/GameEM.h"
+#include "nanaka/main/INanaka.h"
+#include "nanaka/main/World.h"
+
+#include "main/BillboardET.h"
+#include "main/CameraObjectET.h"
+#include "main/ComboController.h"
+#include "main/EntityTypes.h"
+#include "main/Player.h"
+#include "main/PlayerET.h"
+#include "main/SimulationState.h"
+#include "main/TimeController.h"
+#include "main/TriggerET.h"
+#include "main/TriggerManager.h"
+
+void Simulation::RegisterEntityTypes(INanaka* nanaka)
+{
+	auto& entitySystem = nanaka->GetEntitySystem();
+	entitySystem.RegisterEntityType<PlayerET>(PlayerEntityType);
+	entitySystem.RegisterEntityType<TriggerET>(TriggerEntityType);
+	entitySystem.RegisterEntityType<BillboardET>(BillboardEntityType);
+	entitySystem.RegisterEntityType<CameraObjectET>(CameraEntityType);
+}
+
+Simulation::Simulation(INanaka* nanaka)
+	: m_world(std::make_shared<World>())
+	, m_seed(0)
+{
+	auto& entitySystem = nanaka->GetEntitySystem();
+
+	// Set up the same objects as Game does.
+	m_world->GetPhysicsMgr().SetHandleResponse(
+		entitySystem.GetEntityTypeId(TriggerEntityType),
+		entitySystem.GetEntityTypeId(PlayerEntityType), true);
+
+	m_timeController = std::unique_ptr<TimeController>(
+		new TimeController());
+
+	m_comboController = std::unique_ptr<ComboController>(
+		new ComboController(*m_timeController, m_tunables));
+
+	PlayerEMParams playerParams(
+		*m_comboController, *m_timeController, m_tunables);
+	auto playerEntity = entitySystem.SpawnEntity(
+		PlayerEntityType, &playerParams, &m_world->GetEntityTree());
+	m_player = &playerEntity->GetModule<GameEM>()->GetGameObject<Player>();
+
+	m_triggerManager = std::unique_ptr<TriggerManager>(new TriggerManager(
+		nanaka,
+		*m_player,
+		*m_timeController,
+		*m_comboController,
+		m_tunables,
+		m_world,
+		false));
+
+	Restart(m_seed);
+}
+
+Simulation::~Simulation()
+{
+}
+
+void Simulation::SetTunables(const Tunables& tunables)
+{
+	m_tunables = tunables;
+	Restart(m_seed);
+}
+
+void Simulation::Restart(unsigned int seed)
+{
+	m_seed = seed;
+	m_triggerManager->Seed(seed);
+	m_triggerManager->Reset(0.0f);
+	m_player->Reset(0.0f);
+	m_comboController->Reset();
+	m_timeController->Reset();
+}
+
+void Simulation::KickOff(float angle, float strength)
+{
+	m_player->KickOff(angle, strength);
+	m_triggerManager->KickOff();
+}
+
+void Simulation::Touch()
+{
+	// Same as Game::ScreenTouched.
+	if (m_comboController->IsComboActivated())
+	{
+		m_player->AddComboScore(m_comboController->ExecuteCombo());
+	}
+	else
+	{
+		m_player->Soar();
+	}
+}
+
+void Simulation::Step()
+{
+	// Same as one simulation step in Game::Update. The game objects move by
+	// the time controller, so the time the engine measures for the world
+	// tick makes no difference.
+	m_timeController->Step();
+	m_world->Tick();
+	m_triggerManager->Update(
+		m_player->GetEntity()->GetPosition().x, !m_player->HasPass());
+	m_comboController->Update(m_timeController->GetRealStep());
+
+	if (m_player->IsPastOriginShift())
+	{
+		m_player->ShiftOrigin(Player::s_originShift);
+		m_triggerManager->ShiftOrigin(Player::s_originShift);
+	}
+}
+
+bool Simulation::CanTouch() const
+{
+	return m_comboController->IsComboActivated() || m_player->CanSoar();
+}
+
+bool Simulation::IsStopped() const
+{
+	return m_player->IsStopped();
+}
+
+float Simulation::GetDistance() const
+{
+	return static_cast<float>(m_player->GetDistance());
+}
+
+void Simulation::HashState(StateHash& hash) const
+{
+	m_player->HashState(hash);
+	m_comboController->HashState(hash);
+	m_triggerManager->HashState(hash);
+	m_timeController->HashState(hash);
+}
+
+void Simulation::SaveState(SimulationState& state) const
+{
+	m_player->SaveState(state);
+	m_comboController->SaveState(state);
+	m_triggerManager->SaveState(state);
+	m_timeController->SaveState(state);
+}
+
+void Simulation::RestoreState(const SimulationState& state)
+{
+	// The triggers first, the combo controller refers to one of them.
+	m_triggerManager->RestoreState(state);
+	m_player->RestoreState(state);
+	m_comboController->RestoreState(state, state.m_comboActive
+		? m_triggerManager->GetTrigger(state.m_activeTriggerType) : NULL);
+	m_timeController->RestoreState(state);
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_BENCH_SIMULATION_H
+#define HOBO_BENCH_SIMULATION_H
+
+#include <memory>
+
+#include "main/Tunables.h"
+
+class ComboController;
+class INanaka;
+class Player;
+class StateHash;
+class TimeController;
+class TriggerManager;
+class World;
+struct SimulationState;
+
+/**
+ * The gameplay of Game without any presentation, stepped explicitly by the
+ * headless tools. Each simulation has a world of its own.
+ */
+class Simulation final
+{
+public:
+
+	static void RegisterEntityTypes(INanaka* nanaka);
+
+	Simulation(INanaka* nanaka);
+	~Simulation();
+
+	/**
+	 * Restarts with the last seed, so that nothing set up from the previous
+	 * tunables, such as the trigger spacing, carries over.
+	 */
+	void SetTunables(const Tunables& tunables);
+
+	void Restart(unsigned int seed);
+	void KickOff(float angle, float strength);
+	void Touch();
+
+	/**
+	 * Advances the game by TimeController::s_stepLength of real time, the
+	 * same amount every step regardless of how long it takes to compute.
+	 */
+	void Step();
+
+	/**
+	 * True if touching the screen would do anything, either execute a combo
+	 * or make the player soar.
+	 */
+	bool CanTouch() const;
+
+	bool IsStopped() const;
+	float GetDistance() const;
+
+	void HashState(StateHash& hash) const;
+
+	void SaveState(SimulationState& state) const;
+	void RestoreState(const SimulationState& state);
+
+private:
+
+	std::shared_ptr<World> m_world;
+
+	Tunables m_tunables;
+	unsigned int m_seed;
+
+	std::unique_ptr<TimeController> m_timeController;
+	std::unique_ptr<ComboController> m_comboController;
+	Player* m_player;
+	std::unique_ptr<TriggerManager> m_triggerManager;
+};
+
+#endif // HOBO_BENCH_SIMULATION_H
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nanaka/main/Nanaka.h"
+
+#include "bench/HeadlessApplication.h"
+#include "bench/Simulation.h"
+#include "main/Tunables.h"
+
+struct SweepParam
+{
+	std::string m_name;
+	float m_min;
+	float m_max;
+};
+
+struct SweepOutcome
+{
+	float m_distanceMean;
+	float m_distanceStdDev;
+	float m_distanceMin;
+	float m_distanceMax;
+	float m_stepsMean;
+	float m_touchesMean;
+};
+
+/**
+ * Every combination of levels evenly spaced between min and max.
+ */
+static std::vector<Tunables> MakeGrid(
+	const std::vector<SweepParam>& params,
+	unsigned int numLevels)
+{
+	std::vector<Tunables> configs(1);
+
+	for (const auto& param : params)
+	{
+		std::vector<Tunables> expanded;
+		for (const auto& config : configs)
+		{
+			for (unsigned int level = 0; level < numLevels; ++level)
+			{
+				const float t = numLevels > 1
+					? static_cast<float>(level) / (numLevels - 1) : 0.5f;
+				Tunables tunables = config;
+				*tunables.Find(param.m_name) =
+					param.m_min + (param.m_max - param.m_min) * t;
+				expanded.push_back(tunables);
+			}
+		}
+		configs.swap(expanded);
+	}
+
+	return configs;
+}
+
+/**
+ * Latin hypercube sampling, each parameter range is split in as many strata
+ * as there are samples and every stratum is sampled exactly once.
+ */
+static std::vector<Tunables> MakeLatinHypercube(
+	const std::vector<SweepParam>& params,
+	unsigned int numSamples,
+	unsigned int seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> jitter(0.0f, 1.0f);
+
+	std::vector<Tunables> configs(numSamples);
+	std::vector<unsigned int> strata(numSamples);
+
+	for (const auto& param : params)
+	{
+		for (unsigned int i = 0; i < numSamples; ++i)
+		{
+			strata[i] = i;
+		}
+		std::shuffle(strata.begin(), strata.end(), random);
+
+		for (unsigned int i = 0; i < numSamples; ++i)
+		{
+			const float t = (strata[i] + jitter(random)) / numSamples;
+			*configs[i].Find(param.m_name) =
+				param.m_min + (param.m_max - param.m_min) * t;
+		}
+	}
+
+	return configs;
+}
+
+/**
+ * Plays one game per seed, touching as soon as touching does anything. Games
+ * end after maxSteps simulation steps, 60 per second of game play, so the
+ * outcome is the same on any machine and with any number of threads.
+ */
+static SweepOutcome Evaluate(
+	Simulation& simulation,
+	const Tunables& tunables,
+	unsigned int numSeeds,
+	unsigned int maxSteps,
+	float angle,
+	float strength)
+{
+	simulation.SetTunables(tunables);
+
+	std::vector<float> distances;
+	float totalSteps = 0.0f;
+	float totalTouches = 0.0f;
+
+	for (unsigned int seed = 1; seed <= numSeeds; ++seed)
+	{
+		simulation.Restart(seed);
+		simulation.KickOff(angle, strength);
+
+		unsigned int step = 0;
+		for (; step < maxSteps && !simulation.IsStopped(); ++step)
+		{
+			if (simulation.CanTouch())
+			{
+				simulation.Touch();
+				totalTouches += 1.0f;
+			}
+			simulation.Step();
+		}
+
+		distances.push_back(simulation.GetDistance());
+		totalSteps += step;
+	}
+
+	SweepOutcome outcome;
+	float sum = 0.0f;
+	for (auto distance : distances)
+	{
+		sum += distance;
+	}
+	outcome.m_distanceMean = sum / numSeeds;
+
+	float squaredDeviations = 0.0f;
+	for (auto distance : distances)
+	{
+		const float deviation = distance - outcome.m_distanceMean;
+		squaredDeviations += deviation * deviation;
+	}
+	outcome.m_distanceStdDev = std::sqrt(squaredDeviations / numSeeds);
+
+	const auto minMax = std::minmax_element(distances.begin(), distances.end());
+	outcome.m_distanceMin = *minMax.first;
+	outcome.m_distanceMax = *minMax.second;
+	outcome.m_stepsMean = totalSteps / numSeeds;
+	outcome.m_touchesMean = totalTouches / numSeeds;
+
+	return outcome;
+}
+
+static void PrintUsage()
+{
+	fprintf(stderr,
+		"usage: hobo_sweep --param NAME MIN MAX [--param ...]\n"
+		"                  (--grid LEVELS | --lhs SAMPLES) [--seeds N]\n"
+		"                  [--threads N] [--max-steps N] [--lhs-seed N]\n"
+		"                  [--angle A] [--strength S] [--out FILE]\n"
+		"tunables:");
+	for (const auto& name : Tunables::GetNames())
+	{
+		fprintf(stderr, " %s", name.c_str());
+	}
+	fprintf(stderr, "\n");
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<SweepParam> params;
+	unsigned int numLevels = 0;
+	unsigned int numSamples = 0;
+	unsigned int numSeeds = 8;
+	unsigned int numThreads = std::thread::hardware_concurrency();
+	unsigned int maxSteps = 36000;
+	unsigned int lhsSeed = 1;
+	float angle = 0.785f;
+	float strength = 30.0f;
+	std::string outFilePath;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--param") == 0 && i + 3 < argc)
+		{
+			SweepParam param = { argv[i + 1],
+				static_cast<float>(atof(argv[i + 2])),
+				static_cast<float>(atof(argv[i + 3])) };
+			if (!Tunables().Find(param.m_name))
+			{
+				fprintf(stderr, "unknown tunable %s\n", argv[i + 1]);
+				PrintUsage();
+				return 1;
+			}
+			params.push_back(param);
+			i += 3;
+		}
+		else if (strcmp(argv[i], "--grid") == 0 && i + 1 < argc)
+		{
+			numLevels = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--lhs") == 0 && i + 1 < argc)
+		{
+			numSamples = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--seeds") == 0 && i + 1 < argc)
+		{
+			numSeeds = std::max(1, atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			numThreads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--max-steps") == 0 && i + 1 < argc)
+		{
+			maxSteps = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--lhs-seed") == 0 && i + 1 < argc)
+		{
+			lhsSeed = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--angle") == 0 && i + 1 < argc)
+		{
+			angle = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--strength") == 0 && i + 1 < argc)
+		{
+			strength = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+		{
+			outFilePath = argv[++i];
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (params.empty() || (numLevels == 0) == (numSamples == 0))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	const auto configs = numLevels > 0
+		? MakeGrid(params, numLevels)
+		: MakeLatinHypercube(params, numSamples, lhsSeed);
+
+	FILE* out = stdout;
+	if (!outFilePath.empty())
+	{
+		out = fopen(outFilePath.c_str(), "w");
+		if (!out)
+		{
+			fprintf(stderr, "could not write %s\n", outFilePath.c_str());
+			return 1;
+		}
+	}
+
+	HeadlessApplication app;
+	Nanaka nanaka(app);
+	Simulation::RegisterEntityTypes(&nanaka);
+
+	// All entities are spawned here, the workers only step their own worlds.
+	numThreads = std::min<unsigned int>(numThreads, configs.size());
+	numThreads = std::max(1u, numThreads);
+	std::vector<std::unique_ptr<Simulation>> workers;
+	for (unsigned int i = 0; i < numThreads; ++i)
+	{
+		workers.push_back(std::unique_ptr<Simulation>(new Simulation(&nanaka)));
+	}
+
+	std::vector<SweepOutcome> outcomes(configs.size());
+	std::atomic<size_t> nextConfig(0);
+	std::atomic<size_t> numDone(0);
+
+	auto work = [&](Simulation& simulation)
+	{
+		for (size_t i = nextConfig++; i < configs.size(); i = nextConfig++)
+		{
+			outcomes[i] = Evaluate(
+				simulation, configs[i], numSeeds, maxSteps, angle, strength);
+
+			const size_t done = ++numDone;
+			if (done % 100 == 0)
+			{
+				fprintf(stderr, "%zu/%zu\n", done, configs.size());
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < workers.size(); ++i)
+	{
+		threads.push_back(std::thread(work, std::ref(*workers[i])));
+	}
+	work(*workers[0]);
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (const auto& param : params)
+	{
+		fprintf(out, "%s,", param.m_name.c_str());
+	}
+	fprintf(out, "distanceMean,distanceStdDev,distanceMin,distanceMax,"
+		"stepsMean,touchesMean\n");
+
+	for (size_t i = 0; i < configs.size(); ++i)
+	{
+		Tunables config = configs[i];
+		for (const auto& param : params)
+		{
+			fprintf(out, "%g,", *config.Find(param.m_name));
+		}
+
+		const auto& outcome = outcomes[i];
+		fprintf(out, "%.3f,%.3f,%.3f,%.3f,%.1f,%.2f\n",
+			outcome.m_distanceMean,
+			outcome.m_distanceStdDev,
+			outcome.m_distanceMin,
+			outcome.m_distanceMax,
+			outcome.m_stepsMean,
+			outcome.m_touchesMean);
+	}
+
+	if (out != stdout)
+	{
+		fclose(out);
+	}
+
+	return 0;
+}
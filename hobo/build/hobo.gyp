@@ -1,4 +1,7 @@
 {
+  'variables': {
+    'hobo_latency_probe%': 0,
+  },
   'targets': [
     {
       'target_name': 'hobo',
@@ -12,6 +15,13 @@
         '../main/main.gypi',
         '../gui/gui.gypi',
       ],
+      'conditions': [
+        ['hobo_latency_probe==1', {
+          'defines': [
+            'HOBO_LATENCY_PROBE',
+          ],
+        }],
+      ],
     },
   ],
 }
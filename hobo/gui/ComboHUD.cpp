@@ -28,24 +28,27 @@
 #include "nanaka/gui/Counter.h"
 #include "nanaka/gui/Panel.h"
 
+#include "gui/WidgetArena.h"
+
 const float ComboHUD::s_activeAlpha = 1.0f;
 const float ComboHUD::s_inactiveAlpha = 0.2f;
 
 ComboHUD::ComboHUD(
 	std::shared_ptr<Panel> container,
-	std::shared_ptr<Counter> comboTimer)
+	std::shared_ptr<Counter> comboTimer,
+	std::shared_ptr<WidgetArena> widgetArena)
 {
 	LayoutProperties containerLayoutProps;
 	containerLayoutProps.m_aspectRatio = 4.0f;
 	container->SetLayoutProperties(containerLayoutProps);
 
-	m_block45Panel = std::make_shared<Panel>();
+	m_block45Panel = MakeWidget<Panel>(widgetArena);
 	m_block45Panel->SetBackground(
 		"GUI/HUD/Block45ComboLayover.png", Vec4f(1.0f));
-	m_block60Panel = std::make_shared<Panel>();
+	m_block60Panel = MakeWidget<Panel>(widgetArena);
 	m_block60Panel->SetBackground(
 		"GUI/HUD/Block60ComboLayover.png", Vec4f(1.0f));
-	m_passPanel = std::make_shared<Panel>();
+	m_passPanel = MakeWidget<Panel>(widgetArena);
 	m_passPanel->SetBackground("GUI/HUD/PassComboLayover.png", Vec4f(1.0f));
 
 	LayoutProperties layoverPanelsLayoutProps;
@@ -55,19 +58,19 @@ ComboHUD::ComboHUD(
 	m_block60Panel->SetLayoutProperties(layoverPanelsLayoutProps);
 	m_passPanel->SetLayoutProperties(layoverPanelsLayoutProps);
 
-	m_combos = std::make_shared<Panel>();
+	m_combos = MakeWidget<Panel>(widgetArena);
 	m_combos->SetLayoutMethod(LayoutMethod(
 		LayoutMethod::Linear, LayoutMethod::Horizontal,
 		LayoutMethod::Left, LayoutMethod::Bottom));
 
 	Vec4f panelColor(1.0f, 1.0f, 1.0f, s_inactiveAlpha);
-	m_stopPanel = std::make_shared<Panel>();
+	m_stopPanel = MakeWidget<Panel>(widgetArena);
 	m_stopPanel->SetBackground("GUI/HUD/StopCombo.png", panelColor);
-	m_boost30Panel = std::make_shared<Panel>();
+	m_boost30Panel = MakeWidget<Panel>(widgetArena);
 	m_boost30Panel->SetBackground("GUI/HUD/Boost30Combo.png", panelColor);
-	m_boost45Panel = std::make_shared<Panel>();
+	m_boost45Panel = MakeWidget<Panel>(widgetArena);
 	m_boost45Panel->SetBackground("GUI/HUD/Boost45Combo.png", panelColor);
-	m_boost60Panel = std::make_shared<Panel>();
+	m_boost60Panel = MakeWidget<Panel>(widgetArena);
 	m_boost60Panel->SetBackground("GUI/HUD/Boost60Combo.png", panelColor);
 
 	m_combos->AddWidget(m_stopPanel);
@@ -30,6 +30,7 @@
 
 class Counter;
 class Panel;
+class WidgetArena;
 
 class ComboHUD final
 {
@@ -37,7 +38,8 @@ public:
 
 	ComboHUD(
 		std::shared_ptr<Panel> container,
-		std::shared_ptr<Counter> comboTimer);
+		std::shared_ptr<Counter> comboTimer,
+		std::shared_ptr<WidgetArena> widgetArena);
 
 	void SetComboAvailability(
 		bool stop,
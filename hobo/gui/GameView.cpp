@@ -35,45 +35,47 @@ GameView::GameView(
 	std::function<void(void)> backButtonCallback,
 	const Font& font)
 	: m_backButtonCallback(backButtonCallback)
+	, m_widgetArena(std::make_shared<WidgetArena>())
 {
 	// Player HUD
-	auto FPSPanel = std::make_shared<Panel>();
-	auto soarPanel = std::make_shared<Panel>();
-	auto ascentPanel = std::make_shared<Panel>();
-	auto speedPanel = std::make_shared<Panel>();
-	auto scorePanel = std::make_shared<Panel>();
-	auto heightPanel = std::make_shared<Panel>();
+	auto FPSPanel = MakeWidget<Panel>(m_widgetArena);
+	auto soarPanel = MakeWidget<Panel>(m_widgetArena);
+	auto ascentPanel = MakeWidget<Panel>(m_widgetArena);
+	auto speedPanel = MakeWidget<Panel>(m_widgetArena);
+	auto scorePanel = MakeWidget<Panel>(m_widgetArena);
+	auto heightPanel = MakeWidget<Panel>(m_widgetArena);
 
 	m_playerHUD = std::unique_ptr<PlayerHUD>(new PlayerHUD(
 		FPSPanel, soarPanel, ascentPanel, speedPanel, scorePanel, heightPanel,
-		font));
+		font, m_widgetArena));
 
 	// Combo HUD
-	auto comboPanel = std::make_shared<Panel>();
-	auto comboTimerCounter =
-		std::make_shared<Counter>(font, 64.0f, dipGUISizeUnit, 3, 0, ' ');
+	auto comboPanel = MakeWidget<Panel>(m_widgetArena);
+	auto comboTimerCounter = MakeWidget<Counter>(
+		m_widgetArena, font, 64.0f, dipGUISizeUnit, 3, 0, ' ');
 
 	m_comboHUD = std::unique_ptr<ComboHUD>(new ComboHUD(
-		comboPanel, comboTimerCounter));
+		comboPanel, comboTimerCounter, m_widgetArena));
 
 	// Trigger HUD
-	auto triggerPanel = std::make_shared<Panel>();
+	auto triggerPanel = MakeWidget<Panel>(m_widgetArena);
 
-	m_triggerHUD = std::unique_ptr<TriggerHUD>(new TriggerHUD(triggerPanel));
+	m_triggerHUD = std::unique_ptr<TriggerHUD>(new TriggerHUD(
+		triggerPanel, m_widgetArena));
 
 	// Render panel
-	m_renderPanel = std::make_shared<RenderTargetPanel>();
+	m_renderPanel = MakeWidget<RenderTargetPanel>(m_widgetArena);
 	m_renderPanel->SetListener(this);
 
 	// HUD panel
-	auto HUDPanel = std::make_shared<Panel>();
+	auto HUDPanel = MakeWidget<Panel>(m_widgetArena);
 
 	LayoutProperties HUDPanelLayoutProps;
 	HUDPanelLayoutProps.m_z = 1;
 	HUDPanel->SetLayoutProperties(HUDPanelLayoutProps);
 
 	// Pause panel
-	m_pausePanel = std::make_shared<Panel>();
+	m_pausePanel = MakeWidget<Panel>(m_widgetArena);
 	m_pausePanel->SetBackground("", Vec4f(0.0f, 0.0f, 0.0f, 0.4f));
 	m_pausePanel->SetListener(this);
 	m_pausePanel->SetSwallowsInput(true);
@@ -83,25 +85,37 @@ GameView::GameView(
 	m_pausePanel->SetLayoutProperties(pausedPanelLayoutProps);
 
 	// GUI panel
-	auto GUIPanel = std::make_shared<Panel>();
+	auto GUIPanel = MakeWidget<Panel>(m_widgetArena);
 
 	LayoutProperties GUIPanelLayoutProps;
 	GUIPanelLayoutProps.m_z = 3;
 	GUIPanel->SetLayoutProperties(GUIPanelLayoutProps);
 
+	// Latency marker panel, flashed on frames showing the effect of a tap.
+	m_latencyMarkerPanel = MakeWidget<Panel>(m_widgetArena);
+	m_latencyMarkerPanel->SetBackground("", Vec4f(1.0f));
+	m_latencyMarkerPanel->SetVisible(false);
+
+	LayoutProperties latencyMarkerLayoutProps;
+	latencyMarkerLayoutProps.m_relPosition = Vec2f(0.0f);
+	latencyMarkerLayoutProps.m_relSize = Vec2f(0.05f);
+	latencyMarkerLayoutProps.m_z = 4;
+	m_latencyMarkerPanel->SetLayoutProperties(latencyMarkerLayoutProps);
+
 	// View
-	m_viewPanel = std::make_shared<Panel>();
+	m_viewPanel = MakeWidget<Panel>(m_widgetArena);
 	m_viewPanel->AddWidget(m_renderPanel);
 	m_viewPanel->AddWidget(HUDPanel);
 	m_viewPanel->AddWidget(m_pausePanel);
 	m_viewPanel->AddWidget(GUIPanel);
+	m_viewPanel->AddWidget(m_latencyMarkerPanel);
 
 	// HUD panel
 	{
 		HUDPanel->SetLayoutMethod(LayoutMethod(LayoutMethod::Linear));
 
-		auto GUISpacerPanel = std::make_shared<Panel>();
-		auto HUDContentPanel = std::make_shared<Panel>();
+		auto GUISpacerPanel = MakeWidget<Panel>(m_widgetArena);
+		auto HUDContentPanel = MakeWidget<Panel>(m_widgetArena);
 		LayoutProperties HUDPanelLayoutProps;
 		HUDPanelLayoutProps.m_sizeWeight = 4.0f;
 		HUDContentPanel->SetLayoutProperties(HUDPanelLayoutProps);
@@ -112,9 +126,9 @@ GameView::GameView(
 		HUDContentPanel->SetLayoutMethod(LayoutMethod(
 			LayoutMethod::Linear, LayoutMethod::Horizontal));
 
-		auto HUDLeftPanel = std::make_shared<Panel>();
-		auto HUDMiddlePanel = std::make_shared<Panel>();
-		auto HUDRightPanel = std::make_shared<Panel>();
+		auto HUDLeftPanel = MakeWidget<Panel>(m_widgetArena);
+		auto HUDMiddlePanel = MakeWidget<Panel>(m_widgetArena);
+		auto HUDRightPanel = MakeWidget<Panel>(m_widgetArena);
 
 		HUDContentPanel->AddWidget(HUDLeftPanel);
 		HUDContentPanel->AddWidget(HUDMiddlePanel);
@@ -124,8 +138,8 @@ GameView::GameView(
 		{
 			HUDLeftPanel->SetLayoutMethod(LayoutMethod(LayoutMethod::Linear));
 
-			auto spacerPanel = std::make_shared<Panel>();
-			auto HUDLeftContentPanel = std::make_shared<Panel>();
+			auto spacerPanel = MakeWidget<Panel>(m_widgetArena);
+			auto HUDLeftContentPanel = MakeWidget<Panel>(m_widgetArena);
 			LayoutProperties HUDLeftContentLayoutProps;
 			HUDLeftContentLayoutProps.m_sizeWeight = 3.0f;
 			HUDLeftContentLayoutProps.m_growVertically = true;
@@ -147,8 +161,8 @@ GameView::GameView(
 		{
 			HUDMiddlePanel->SetLayoutMethod(LayoutMethod(LayoutMethod::Linear));
 
-			auto spacerPanel = std::make_shared<Panel>();
-			auto HUDMiddleContentPanel = std::make_shared<Panel>();
+			auto spacerPanel = MakeWidget<Panel>(m_widgetArena);
+			auto HUDMiddleContentPanel = MakeWidget<Panel>(m_widgetArena);
 			LayoutProperties HUDMiddleContentLayoutProps;
 			HUDMiddleContentLayoutProps.m_sizeWeight = 3.0f;
 			HUDMiddleContentLayoutProps.m_growVertically = true;
@@ -158,12 +172,13 @@ GameView::GameView(
 			HUDMiddlePanel->AddWidget(spacerPanel);
 			HUDMiddlePanel->AddWidget(HUDMiddleContentPanel);
 
-			auto DPadPanel = std::make_shared<Panel>();
+			auto DPadPanel = MakeWidget<Panel>(m_widgetArena);
 			LayoutProperties DPadPanelLayoutProps;
 			DPadPanelLayoutProps.m_aspectRatio = 1.0f;
 			DPadPanel->SetLayoutProperties(DPadPanelLayoutProps);
 
-			m_DPad = std::make_shared<DPad>("GUI/HUD/DPad.png", Vec4f(1.0f));
+			m_DPad = MakeWidget<DPad>(
+				m_widgetArena, "GUI/HUD/DPad.png", Vec4f(1.0f));
 			m_DPad->SetListener(this);
 			LayoutProperties DPadLayoutProps;
 			DPadLayoutProps.m_relPosition = Vec2f(0.1f);
@@ -171,7 +186,7 @@ GameView::GameView(
 			m_DPad->SetLayoutProperties(DPadLayoutProps);
 			DPadPanel->AddWidget(m_DPad);
 
-			auto comboTimerPanel = std::make_shared<Panel>();
+			auto comboTimerPanel = MakeWidget<Panel>(m_widgetArena);
 			comboTimerPanel->SetLayoutMethod(
 				LayoutMethod(LayoutMethod::Linear));
 			comboTimerPanel->AddWidget(comboTimerCounter);
@@ -198,8 +213,8 @@ GameView::GameView(
 	{
 		GUIPanel->SetLayoutMethod(LayoutMethod(LayoutMethod::Linear));
 
-		auto GUIContentPanel = std::make_shared<Panel>();
-		auto HUDSpacerPanel = std::make_shared<Panel>();
+		auto GUIContentPanel = MakeWidget<Panel>(m_widgetArena);
+		auto HUDSpacerPanel = MakeWidget<Panel>(m_widgetArena);
 		LayoutProperties HUDSpacerPanelLayoutProps;
 		HUDSpacerPanelLayoutProps.m_sizeWeight = 4.0f;
 		HUDSpacerPanel->SetLayoutProperties(HUDSpacerPanelLayoutProps);
@@ -210,8 +225,8 @@ GameView::GameView(
 		GUIContentPanel->SetLayoutMethod(LayoutMethod(
 			LayoutMethod::Linear, LayoutMethod::Horizontal));
 
-		auto GUILeftPanel = std::make_shared<Panel>();
-		auto GUIRightPanel = std::make_shared<Panel>();
+		auto GUILeftPanel = MakeWidget<Panel>(m_widgetArena);
+		auto GUIRightPanel = MakeWidget<Panel>(m_widgetArena);
 
 		GUIContentPanel->AddWidget(GUILeftPanel);
 		GUIContentPanel->AddWidget(GUIRightPanel);
@@ -222,7 +237,7 @@ GameView::GameView(
 				LayoutMethod::Linear, LayoutMethod::Horizontal,
 				LayoutMethod::Left, LayoutMethod::VCenter));
 
-			auto backButtonPressedPanel = std::make_shared<Panel>();
+			auto backButtonPressedPanel = MakeWidget<Panel>(m_widgetArena);
 			backButtonPressedPanel->SetBackground(
 				"", Vec4f(0.0f, 1.0f, 0.0f, 0.5f));
 			backButtonPressedPanel->SetBorder(
@@ -231,10 +246,10 @@ GameView::GameView(
 				Frame::TopEdge | Frame::RightEdge);
 			backButtonPressedPanel->SetLayoutMethod(
 				LayoutMethod(LayoutMethod::Linear));
-			backButtonPressedPanel->AddWidget(std::make_shared<StaticText>(
-				"BaCk", font, 32.0f, dipGUISizeUnit));
+			backButtonPressedPanel->AddWidget(MakeWidget<StaticText>(
+				m_widgetArena, "BaCk", font, 32.0f, dipGUISizeUnit));
 
-			auto backButtonReleasedPanel = std::make_shared<Panel>();
+			auto backButtonReleasedPanel = MakeWidget<Panel>(m_widgetArena);
 			backButtonReleasedPanel->SetBackground(
 				"", Vec4f(0.0f, 1.0f, 0.0f, 1.0f));
 			backButtonReleasedPanel->SetBorder(
@@ -243,11 +258,11 @@ GameView::GameView(
 				Frame::TopEdge | Frame::RightEdge);
 			backButtonReleasedPanel->SetLayoutMethod(
 				LayoutMethod(LayoutMethod::Linear));
-			backButtonReleasedPanel->AddWidget(std::make_shared<StaticText>(
-				"BaCk", font, 32.0f, dipGUISizeUnit));
+			backButtonReleasedPanel->AddWidget(MakeWidget<StaticText>(
+				m_widgetArena, "BaCk", font, 32.0f, dipGUISizeUnit));
 
-			m_backButton = std::make_shared<Button>(
-				backButtonPressedPanel, backButtonReleasedPanel);
+			m_backButton = MakeWidget<Button>(
+				m_widgetArena, backButtonPressedPanel, backButtonReleasedPanel);
 			m_backButton->SetListener(this);
 
 			LayoutProperties buttonLayoutProps;
@@ -265,7 +280,7 @@ GameView::GameView(
 				LayoutMethod::Linear, LayoutMethod::Horizontal,
 				LayoutMethod::Right, LayoutMethod::VCenter));
 
-			auto restartButtonPressedPanel = std::make_shared<Panel>();
+			auto restartButtonPressedPanel = MakeWidget<Panel>(m_widgetArena);
 			restartButtonPressedPanel->SetBackground(
 				"", Vec4f(0.0f, 1.0f, 0.0f, 0.5f));
 			restartButtonPressedPanel->SetBorder(
@@ -274,10 +289,10 @@ GameView::GameView(
 				Frame::TopEdge | Frame::LeftEdge);
 			restartButtonPressedPanel->SetLayoutMethod(
 				LayoutMethod(LayoutMethod::Linear));
-			restartButtonPressedPanel->AddWidget(std::make_shared<StaticText>(
-				"ReStArT", font, 32.0f, dipGUISizeUnit));
+			restartButtonPressedPanel->AddWidget(MakeWidget<StaticText>(
+				m_widgetArena, "ReStArT", font, 32.0f, dipGUISizeUnit));
 
-			auto restartButtonReleasedPanel = std::make_shared<Panel>();
+			auto restartButtonReleasedPanel = MakeWidget<Panel>(m_widgetArena);
 			restartButtonReleasedPanel->SetBackground(
 				"", Vec4f(0.0f, 1.0f, 0.0f, 1.0f));
 			restartButtonReleasedPanel->SetBorder(
@@ -286,11 +301,12 @@ GameView::GameView(
 				Frame::TopEdge | Frame::LeftEdge);
 			restartButtonReleasedPanel->SetLayoutMethod(
 				LayoutMethod(LayoutMethod::Linear));
-			restartButtonReleasedPanel->AddWidget(std::make_shared<StaticText>(
-				"ReStArT", font, 32.0f, dipGUISizeUnit));
+			restartButtonReleasedPanel->AddWidget(MakeWidget<StaticText>(
+				m_widgetArena, "ReStArT", font, 32.0f, dipGUISizeUnit));
 
-			m_restartButton = std::make_shared<Button>(
-				restartButtonPressedPanel, restartButtonReleasedPanel);
+			m_restartButton = MakeWidget<Button>(
+				m_widgetArena, restartButtonPressedPanel,
+				restartButtonReleasedPanel);
 			m_restartButton->SetListener(this);
 
 			LayoutProperties buttonLayoutProps;
@@ -360,6 +376,11 @@ void GameView::DPadInput(UUID DPadId, DPadAction action, Vec2f position)
 	}
 }
 
+void GameView::SetLatencyMarkerVisible(bool visible)
+{
+	m_latencyMarkerPanel->SetVisible(visible);
+}
+
 bool GameView::StateTransition(GameViewState viewState)
 {
 	bool success = false;
@@ -36,6 +36,7 @@
 #include "gui/ComboHUD.h"
 #include "gui/TriggerHUD.h"
 #include "gui/PlayerHUD.h"
+#include "gui/WidgetArena.h"
 
 class Font;
 class GUI;
@@ -81,6 +82,8 @@ public:
 	TriggerHUD& GetTriggerHUD() const;
 	PlayerHUD& GetPlayerHUD() const;
 
+	void SetLatencyMarkerVisible(bool visible);
+
 	/**
 	 * PanelListener implementation.
 	 */
@@ -106,12 +109,15 @@ private:
 
 	std::function<void(void)> m_backButtonCallback;
 
+	std::shared_ptr<WidgetArena> m_widgetArena;
+
 	std::shared_ptr<RenderTargetPanel> m_renderPanel;
 	std::shared_ptr<Panel> m_viewPanel;
 	std::shared_ptr<Button> m_backButton;
 	std::shared_ptr<Button> m_restartButton;
 	std::shared_ptr<Panel> m_pausePanel;
 	std::shared_ptr<DPad> m_DPad;
+	std::shared_ptr<Panel> m_latencyMarkerPanel;
 
 	std::unique_ptr<ComboHUD> m_comboHUD;
 	std::unique_ptr<TriggerHUD> m_triggerHUD;
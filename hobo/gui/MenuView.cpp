@@ -25,49 +25,63 @@
 
 #include "gui/MenuView.h"
 
+#include "nanaka/gui/Counter.h"
 #include "nanaka/gui/Image.h"
 #include "nanaka/gui/Panel.h"
 #include "nanaka/gui/RenderTargetPanel.h"
 #include "nanaka/gui/StaticText.h"
 
+#include "gui/WidgetArena.h"
+
 MenuView::MenuView(
 	std::function<void(void)> playButtonCallback,
 	const Font& font)
 	: m_viewState(MenuViewStateNonstarted)
 	, m_playButtonCallback(playButtonCallback)
+	, m_widgetArena(std::make_shared<WidgetArena>())
 {
 	// Render panel
-	m_renderPanel = std::make_shared<RenderTargetPanel>();
+	m_renderPanel = MakeWidget<RenderTargetPanel>(m_widgetArena);
 
 	// Button panel
-	auto buttonPanel = std::make_shared<Panel>();
+	auto buttonPanel = MakeWidget<Panel>(m_widgetArena);
 
 	LayoutProperties buttonPanelLayoutProps;
 	buttonPanelLayoutProps.m_z = 1;
 	buttonPanel->SetLayoutProperties(buttonPanelLayoutProps);
 
 	// Exit dialogue panel
-	m_exitDialogue = std::make_shared<Panel>();
+	m_exitDialogue = MakeWidget<Panel>(m_widgetArena);
 	m_exitDialogue->SetSwallowsInput(true);
 
 	LayoutProperties exitDialogueLayoutProps;
 	exitDialogueLayoutProps.m_z = 2;
 	m_exitDialogue->SetLayoutProperties(exitDialogueLayoutProps);
 
+	// Highscore board panel
+	m_highscoreBoard = MakeWidget<Panel>(m_widgetArena);
+	m_highscoreBoard->SetSwallowsInput(true);
+	m_highscoreBoard->SetVisible(false);
+
+	LayoutProperties highscoreBoardLayoutProps;
+	highscoreBoardLayoutProps.m_z = 2;
+	m_highscoreBoard->SetLayoutProperties(highscoreBoardLayoutProps);
+
 	// View
-	m_viewPanel = std::make_shared<Panel>();
+	m_viewPanel = MakeWidget<Panel>(m_widgetArena);
 	m_viewPanel->AddWidget(m_renderPanel);
 	m_viewPanel->AddWidget(buttonPanel);
 	m_viewPanel->AddWidget(m_exitDialogue);
+	m_viewPanel->AddWidget(m_highscoreBoard);
 
 	// Button panel
 	{
 		buttonPanel->SetLayoutMethod(LayoutMethod(
 			LayoutMethod::Linear, LayoutMethod::Horizontal));
 
-		auto leftPanel = std::make_shared<Panel>();
-		auto middlePanel = std::make_shared<Panel>();
-		auto rightPanel = std::make_shared<Panel>();
+		auto leftPanel = MakeWidget<Panel>(m_widgetArena);
+		auto middlePanel = MakeWidget<Panel>(m_widgetArena);
+		auto rightPanel = MakeWidget<Panel>(m_widgetArena);
 
 		LayoutProperties middlePanelLayoutProps;
 		middlePanelLayoutProps.m_sizeWeight = 2.0f;
@@ -115,13 +129,14 @@ MenuView::MenuView(
 				LayoutMethod::Linear, LayoutMethod::Vertical,
 				LayoutMethod::HCenter, LayoutMethod::Top));
 
-			auto spacerPanel = std::make_shared<Panel>();
+			auto spacerPanel = MakeWidget<Panel>(m_widgetArena);
 			LayoutProperties spacerProps;
 			spacerProps.m_aspectRatio = 4.0f;
 			spacerPanel->SetLayoutProperties(spacerProps);
 
-			auto titleImage = std::make_shared<Image>(
-				"GUI/Menu/Title.png", Vec4f(1.0f), Vec2f(0.0f), pxGUISizeUnit);
+			auto titleImage = MakeWidget<Image>(
+				m_widgetArena, "GUI/Menu/Title.png", Vec4f(1.0f), Vec2f(0.0f),
+				pxGUISizeUnit);
 			LayoutProperties titleImageLayoutProps;
 			titleImageLayoutProps.m_aspectRatio = 2.0f;
 			titleImage->SetLayoutProperties(titleImageLayoutProps);
@@ -133,10 +148,10 @@ MenuView::MenuView(
 
 	// Exit dialogue
 	{
-		auto shadingPanel = std::make_shared<Panel>();
+		auto shadingPanel = MakeWidget<Panel>(m_widgetArena);
 		shadingPanel->SetBackground("", Vec4f(0.0f, 0.0f, 0.0f, 0.5f));
 
-		auto popupPanel = std::make_shared<Panel>();
+		auto popupPanel = MakeWidget<Panel>(m_widgetArena);
 		popupPanel->SetBackground("", Vec4f(0.0f, 1.0f, 0.0f, 1.0f));
 		popupPanel->SetBorder(
 			"GUI/edgetest.png", "GUI/cornertest.png",
@@ -154,11 +169,12 @@ MenuView::MenuView(
 
 		// Popup
 		{
-			auto exitQuestionPanel = std::make_shared<Panel>();
+			auto exitQuestionPanel = MakeWidget<Panel>(m_widgetArena);
 			exitQuestionPanel->SetLayoutMethod(LayoutMethod(
 				LayoutMethod::Linear, LayoutMethod::Horizontal));
-			exitQuestionPanel->AddWidget(std::make_shared<StaticText>(
-				"Do YoU rEaLlY wAnT tO eXiT?", font, 48.0f, dipGUISizeUnit));
+			exitQuestionPanel->AddWidget(MakeWidget<StaticText>(
+				m_widgetArena, "Do YoU rEaLlY wAnT tO eXiT?", font, 48.0f,
+				dipGUISizeUnit));
 
 			LayoutProperties exitQuestionLayoutProps;
 			exitQuestionLayoutProps.m_relPosition = Vec2f(0.0f, 0.0f);
@@ -184,9 +200,94 @@ MenuView::MenuView(
 		}
 	}
 
+	// Highscore board
+	{
+		auto shadingPanel = MakeWidget<Panel>(m_widgetArena);
+		shadingPanel->SetBackground("", Vec4f(0.0f, 0.0f, 0.0f, 0.5f));
+
+		auto popupPanel = MakeWidget<Panel>(m_widgetArena);
+		popupPanel->SetBackground("", Vec4f(0.0f, 1.0f, 0.0f, 1.0f));
+		popupPanel->SetBorder(
+			"GUI/edgetest.png", "GUI/cornertest.png",
+			Vec4f(0.0f, 1.0f, 0.0f, 1.0f), 32.0f, dipGUISizeUnit,
+			Frame::AllEdges);
+
+		LayoutProperties popupPanelLayoutProps;
+		popupPanelLayoutProps.m_relPosition = Vec2f(0.1f, 0.1f);
+		popupPanelLayoutProps.m_relSize = Vec2f(0.8f, 0.8f);
+		popupPanelLayoutProps.m_z = 1;
+		popupPanel->SetLayoutProperties(popupPanelLayoutProps);
+
+		m_highscoreBoard->AddWidget(shadingPanel);
+		m_highscoreBoard->AddWidget(popupPanel);
+
+		// Popup
+		{
+			auto listPanel = MakeWidget<Panel>(m_widgetArena);
+			listPanel->SetLayoutMethod(LayoutMethod(
+				LayoutMethod::Linear, LayoutMethod::Vertical,
+				LayoutMethod::HCenter, LayoutMethod::Top));
+
+			LayoutProperties listLayoutProps;
+			listLayoutProps.m_relPosition = Vec2f(0.0f, 0.0f);
+			listLayoutProps.m_relSize = Vec2f(1.0f, 0.8f);
+			listPanel->SetLayoutProperties(listLayoutProps);
+
+			// Rows are filled in when the board is shown.
+			for (size_t i = 0; i < s_numHighscoreRows; ++i)
+			{
+				auto rowPanel = MakeWidget<Panel>(m_widgetArena);
+				rowPanel->SetLayoutMethod(LayoutMethod(
+					LayoutMethod::Linear, LayoutMethod::Horizontal));
+
+				auto rankText = MakeWidget<StaticText>(
+					m_widgetArena, std::to_string(i + 1) + ". ", font, 32.0f,
+					dipGUISizeUnit);
+				auto distanceCounter = MakeWidget<Counter>(
+					m_widgetArena, font, 32.0f, dipGUISizeUnit, 8, 2, ' ');
+				auto unitText = MakeWidget<StaticText>(
+					m_widgetArena, "m", font, 32.0f, dipGUISizeUnit);
+
+				rowPanel->AddWidget(rankText);
+				rowPanel->AddWidget(distanceCounter);
+				rowPanel->AddWidget(unitText);
+				listPanel->AddWidget(rowPanel);
+
+				m_highscoreRows.push_back(rowPanel);
+				m_highscoreCounters.push_back(distanceCounter);
+			}
+
+			m_highscoreCloseButton = CreateButton("Ok", true, font);
+
+			LayoutProperties closeButtonLayoutProps;
+			closeButtonLayoutProps.m_relPosition = Vec2f(0.5f, 0.8f);
+			closeButtonLayoutProps.m_relSize = Vec2f(0.5f, 0.2f);
+			m_highscoreCloseButton->SetLayoutProperties(
+				closeButtonLayoutProps);
+
+			popupPanel->AddWidget(listPanel);
+			popupPanel->AddWidget(m_highscoreCloseButton);
+		}
+	}
+
 	SetState(m_viewState);
 }
 
+void MenuView::ShowHighscoreBoard(const std::vector<float>& distances)
+{
+	for (size_t i = 0; i < s_numHighscoreRows; ++i)
+	{
+		const bool used = i < distances.size();
+		m_highscoreRows[i]->SetVisible(used);
+		if (used)
+		{
+			m_highscoreCounters[i]->SetNumber(distances[i]);
+		}
+	}
+
+	m_highscoreBoard->SetVisible(true);
+}
+
 void MenuView::ButtonPushed(UUID buttonId)
 {
 	if (buttonId == m_playButton->GetId())
@@ -198,6 +299,14 @@ void MenuView::ButtonPushed(UUID buttonId)
 	{
 		m_playButtonCallback();
 	}
+	else if (buttonId == m_highscoreButton->GetId())
+	{
+		m_client->OpenHighscoreBoard();
+	}
+	else if (buttonId == m_highscoreCloseButton->GetId())
+	{
+		m_highscoreBoard->SetVisible(false);
+	}
 	else if (buttonId == m_exitButton->GetId())
 	{
 		if (m_viewState == MenuViewStateNonstarted)
@@ -297,25 +406,26 @@ std::shared_ptr<Button> MenuView::CreateButton(
 {
 	std::shared_ptr<Button> button;
 
-	auto buttonPressedState = std::make_shared<Panel>();
+	auto buttonPressedState = MakeWidget<Panel>(m_widgetArena);
 	buttonPressedState->SetLayoutMethod(LayoutMethod(
 		LayoutMethod::Linear, LayoutMethod::Vertical,
 		LayoutMethod::HCenter, LayoutMethod::VCenter));
 	buttonPressedState->SetBackground(
 		"GUI/Menu/Button.png", Vec4f(1.0f), ImageRotationNone, flipH);
-	buttonPressedState->AddWidget(std::make_shared<StaticText>(
-		buttonText, font, 32.0f, dipGUISizeUnit));
+	buttonPressedState->AddWidget(MakeWidget<StaticText>(
+		m_widgetArena, buttonText, font, 32.0f, dipGUISizeUnit));
 
-	auto buttonReleasedState = std::make_shared<Panel>();
+	auto buttonReleasedState = MakeWidget<Panel>(m_widgetArena);
 	buttonReleasedState->SetLayoutMethod(LayoutMethod(
 		LayoutMethod::Linear, LayoutMethod::Vertical,
 		LayoutMethod::HCenter, LayoutMethod::VCenter));
 	buttonReleasedState->SetBackground(
 		"GUI/Menu/Button.png", Vec4f(1.0f), ImageRotationNone, flipH);
-	buttonReleasedState->AddWidget(std::make_shared<StaticText>(
-		buttonText, font, 32.0f, dipGUISizeUnit));
+	buttonReleasedState->AddWidget(MakeWidget<StaticText>(
+		m_widgetArena, buttonText, font, 32.0f, dipGUISizeUnit));
 
-	button = std::make_shared<Button>(buttonPressedState, buttonReleasedState);
+	button = MakeWidget<Button>(
+		m_widgetArena, buttonPressedState, buttonReleasedState);
 	button->SetListener(this);
 
 	LayoutProperties buttonLayoutProps;
@@ -29,10 +29,15 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "nanaka/gui/Button.h"
 
+#include "main/HighscoreStore.h"
+
+class Counter;
 class GUI;
+class WidgetArena;
 class Panel;
 class RenderTargetPanel;
 class Font;
@@ -44,6 +49,7 @@ public:
 	virtual ~MenuViewClient(){}
 
 	virtual void Shutdown() = 0;
+	virtual void OpenHighscoreBoard() = 0;
 };
 
 enum MenuViewState
@@ -67,6 +73,11 @@ public:
 	std::shared_ptr<RenderTargetPanel> GetRenderPanel();
 	std::shared_ptr<Panel> GetViewPanel();
 
+	/**
+	 * Shows the board with the distances of the best runs, best first.
+	 */
+	void ShowHighscoreBoard(const std::vector<float>& distances);
+
 	/**
 	 * ButtonListener implementation.
 	 */
@@ -74,6 +85,8 @@ public:
 
 private:
 
+	static const size_t s_numHighscoreRows = HighscoreStore::s_numTop;
+
 	void SetState(MenuViewState viewState);
 
 	std::shared_ptr<Button> CreateButton(
@@ -85,6 +98,8 @@ private:
 	MenuViewClient* m_client;
 	std::function<void(void)> m_playButtonCallback;
 
+	std::shared_ptr<WidgetArena> m_widgetArena;
+
 	std::shared_ptr<RenderTargetPanel> m_renderPanel;
 	std::shared_ptr<Panel> m_viewPanel;
 
@@ -100,6 +115,11 @@ private:
 	std::shared_ptr<Panel> m_exitDialogue;
 	std::shared_ptr<Button> m_exitYetButton;
 	std::shared_ptr<Button> m_exitNoButton;
+
+	std::shared_ptr<Panel> m_highscoreBoard;
+	std::vector<std::shared_ptr<Panel>> m_highscoreRows;
+	std::vector<std::shared_ptr<Counter>> m_highscoreCounters;
+	std::shared_ptr<Button> m_highscoreCloseButton;
 };
 
 inline void MenuView::SetClient(MenuViewClient* client)
@@ -32,6 +32,8 @@
 #include "nanaka/gui/StaticText.h"
 #include "nanaka/utils/GlobalClock.h"
 
+#include "gui/WidgetArena.h"
+
 PlayerHUD::PlayerHUD(
 	std::shared_ptr<Panel> FPSPanel,
 	std::shared_ptr<Panel> soarPanel,
@@ -39,26 +41,31 @@ PlayerHUD::PlayerHUD(
 	std::shared_ptr<Panel> speedPanel,
 	std::shared_ptr<Panel> scorePanel,
 	std::shared_ptr<Panel> heightPanel,
-	const Font& font)
+	const Font& font,
+	std::shared_ptr<WidgetArena> widgetArena)
 {
-	m_FPSCounter = std::make_shared<Counter>(
-		font, 24.0f, dipGUISizeUnit, 5, 0, ' ');
-	m_speedCounter = std::make_shared<Counter>(
-		font, 24.0f, dipGUISizeUnit, 5, 2, ' ');
-	m_distanceCounter = std::make_shared<Counter>(
-		font, 24.0f, dipGUISizeUnit, 8, 2, ' ');
-
-	m_soarGauge = std::make_shared<Gauge>(
-		false, 16, 4, dipGUISizeUnit, "GUI/HUD/GaugeFullEnd.png",
+	m_FPSCounter = MakeWidget<Counter>(
+		widgetArena, font, 24.0f, dipGUISizeUnit, 5, 0, ' ');
+	m_frameLengthCounter = MakeWidget<Counter>(
+		widgetArena, font, 24.0f, dipGUISizeUnit, 5, 1, ' ');
+	m_detailLevelCounter = MakeWidget<Counter>(
+		widgetArena, font, 24.0f, dipGUISizeUnit, 2, 0, ' ');
+	m_speedCounter = MakeWidget<Counter>(
+		widgetArena, font, 24.0f, dipGUISizeUnit, 5, 2, ' ');
+	m_distanceCounter = MakeWidget<Counter>(
+		widgetArena, font, 24.0f, dipGUISizeUnit, 8, 2, ' ');
+
+	m_soarGauge = MakeWidget<Gauge>(
+		widgetArena, false, 16, 4, dipGUISizeUnit, "GUI/HUD/GaugeFullEnd.png",
 		"GUI/HUD/GaugeEmptyEnd.png", "GUI/HUD/GaugeFullMiddle.png",
 		"GUI/HUD/GaugeEmptyMiddle.png", Vec4f(1.0f));
-	m_ascentGauge = std::make_shared<Gauge>(
-		false, 16, 4, dipGUISizeUnit, "GUI/HUD/GaugeFullEnd.png",
+	m_ascentGauge = MakeWidget<Gauge>(
+		widgetArena, false, 16, 4, dipGUISizeUnit, "GUI/HUD/GaugeFullEnd.png",
 		"GUI/HUD/GaugeEmptyEnd.png", "GUI/HUD/GaugeFullMiddle.png",
 		"GUI/HUD/GaugeEmptyMiddle.png", Vec4f(1.0f));
 
-	m_heightCounter = std::make_shared<Counter>(
-		font, 24.0f, dipGUISizeUnit, 5, 2, ' ');
+	m_heightCounter = MakeWidget<Counter>(
+		widgetArena, font, 24.0f, dipGUISizeUnit, 5, 2, ' ');
 	m_heightPanelVisible = false;
 
 	LayoutProperties growHorizontalPanelLayoutProps;
@@ -70,14 +77,14 @@ PlayerHUD::PlayerHUD(
 			LayoutMethod::Linear, LayoutMethod::Horizontal));
 		speedPanel->SetLayoutProperties(growHorizontalPanelLayoutProps);
 
-		auto speedLabel = std::make_shared<StaticText>(
-			"Speed: ", font, 24.0f, dipGUISizeUnit);
+		auto speedLabel = MakeWidget<StaticText>(
+			widgetArena, "Speed: ", font, 24.0f, dipGUISizeUnit);
 
-		auto spacerPanel = std::make_shared<Panel>();
+		auto spacerPanel = MakeWidget<Panel>(widgetArena);
 		spacerPanel->SetLayoutProperties(growHorizontalPanelLayoutProps);
 
-		auto unitText = std::make_shared<StaticText>(
-			"mps", font, 24.0f, dipGUISizeUnit);
+		auto unitText = MakeWidget<StaticText>(
+			widgetArena, "mps", font, 24.0f, dipGUISizeUnit);
 
 		speedPanel->AddWidget(speedLabel);
 		speedPanel->AddWidget(spacerPanel);
@@ -91,14 +98,14 @@ PlayerHUD::PlayerHUD(
 			LayoutMethod::Linear, LayoutMethod::Horizontal));
 		scorePanel->SetLayoutProperties(growHorizontalPanelLayoutProps);
 
-		auto scoreLabel = std::make_shared<StaticText>(
-			"Distance: ", font, 24.0f, dipGUISizeUnit);
+		auto scoreLabel = MakeWidget<StaticText>(
+			widgetArena, "Distance: ", font, 24.0f, dipGUISizeUnit);
 
-		auto spacerPanel = std::make_shared<Panel>();
+		auto spacerPanel = MakeWidget<Panel>(widgetArena);
 		spacerPanel->SetLayoutProperties(growHorizontalPanelLayoutProps);
 
-		auto unitText = std::make_shared<StaticText>(
-			"m  ", font, 24.0f, dipGUISizeUnit);
+		auto unitText = MakeWidget<StaticText>(
+			widgetArena, "m  ", font, 24.0f, dipGUISizeUnit);
 
 		scorePanel->AddWidget(scoreLabel);
 		scorePanel->AddWidget(spacerPanel);
@@ -113,11 +120,17 @@ PlayerHUD::PlayerHUD(
 			LayoutMethod::Left));
 		FPSPanel->SetLayoutProperties(growHorizontalPanelLayoutProps);
 
-		auto FPSLabel = std::make_shared<StaticText>(
-			"FpS: ", font, 24.0f, dipGUISizeUnit);
+		auto FPSLabel = MakeWidget<StaticText>(
+			widgetArena, "FpS: ", font, 24.0f, dipGUISizeUnit);
+
+		auto frameLengthUnit = MakeWidget<StaticText>(
+			widgetArena, "mS  LoD:", font, 24.0f, dipGUISizeUnit);
 
 		FPSPanel->AddWidget(FPSLabel);
 		FPSPanel->AddWidget(m_FPSCounter);
+		FPSPanel->AddWidget(m_frameLengthCounter);
+		FPSPanel->AddWidget(frameLengthUnit);
+		FPSPanel->AddWidget(m_detailLevelCounter);
 	}
 
 	// Soar panel
@@ -126,8 +139,8 @@ PlayerHUD::PlayerHUD(
 			LayoutMethod::Linear, LayoutMethod::Horizontal));
 		soarPanel->SetLayoutProperties(growHorizontalPanelLayoutProps);
 
-		auto soarLabel = std::make_shared<StaticText>(
-			"SoAr:   ", font, 24.0f, dipGUISizeUnit);
+		auto soarLabel = MakeWidget<StaticText>(
+			widgetArena, "SoAr:   ", font, 24.0f, dipGUISizeUnit);
 
 		soarPanel->AddWidget(soarLabel);
 		soarPanel->AddWidget(m_soarGauge);
@@ -139,8 +152,8 @@ PlayerHUD::PlayerHUD(
 			LayoutMethod::Linear, LayoutMethod::Horizontal));
 		ascentPanel->SetLayoutProperties(growHorizontalPanelLayoutProps);
 
-		auto ascentLabel = std::make_shared<StaticText>(
-			"AsCeNt: ", font, 24.0f, dipGUISizeUnit);
+		auto ascentLabel = MakeWidget<StaticText>(
+			widgetArena, "AsCeNt: ", font, 24.0f, dipGUISizeUnit);
 
 		ascentPanel->AddWidget(ascentLabel);
 		ascentPanel->AddWidget(m_ascentGauge);
@@ -151,21 +164,22 @@ PlayerHUD::PlayerHUD(
 		m_heightPanel = heightPanel;
 		m_heightPanel->SetLayoutMethod(LayoutMethod(LayoutMethod::Linear));
 
-		auto upArrowImage = std::make_shared<Image>(
-			"GUI/HUD/HeightArrow.png", Vec4f(1.0f), Vec2f(0.0f), pxGUISizeUnit);
+		auto upArrowImage = MakeWidget<Image>(
+			widgetArena, "GUI/HUD/HeightArrow.png", Vec4f(1.0f), Vec2f(0.0f),
+			pxGUISizeUnit);
 		LayoutProperties layoutProps;
 		layoutProps.m_aspectRatio = 0.5f;
 		upArrowImage->SetLayoutProperties(layoutProps);
 
-		auto heightTextPanel = std::make_shared<Panel>();
+		auto heightTextPanel = MakeWidget<Panel>(widgetArena);
 
 		// Height text panel
 		{
 			heightTextPanel->SetLayoutMethod(LayoutMethod(
 				LayoutMethod::Linear, LayoutMethod::Horizontal));
 
-			auto heightLabel = std::make_shared<StaticText>(
-				"HeIgHt: ", font, 24.0f, dipGUISizeUnit);
+			auto heightLabel = MakeWidget<StaticText>(
+				widgetArena, "HeIgHt: ", font, 24.0f, dipGUISizeUnit);
 
 			heightTextPanel->AddWidget(heightLabel);
 			heightTextPanel->AddWidget(m_heightCounter);
@@ -203,3 +217,9 @@ void PlayerHUD::Update(
 		m_heightCounter->SetNumber(height);
 	}
 }
+
+void PlayerHUD::SetPerformance(float frameLength, int detailLevel)
+{
+	m_frameLengthCounter->SetNumber(frameLength);
+	m_detailLevelCounter->SetNumber(detailLevel);
+}
@@ -32,6 +32,7 @@ class Panel;
 class Gauge;
 class Counter;
 class Font;
+class WidgetArena;
 
 class PlayerHUD final
 {
@@ -44,7 +45,8 @@ public:
 		std::shared_ptr<Panel> speedPanel,
 		std::shared_ptr<Panel> scorePanel,
 		std::shared_ptr<Panel> heightPanel,
-		const Font& font);
+		const Font& font,
+		std::shared_ptr<WidgetArena> widgetArena);
 
 	void Update(
 		float speed,
@@ -53,9 +55,16 @@ public:
 		float ascentLoad,
 		float height);
 
+	/**
+	 * Shown next to the FPS, the detail level is 0 at full detail.
+	 */
+	void SetPerformance(float frameLength, int detailLevel);
+
 private:
 
 	std::shared_ptr<Counter> m_FPSCounter;
+	std::shared_ptr<Counter> m_frameLengthCounter;
+	std::shared_ptr<Counter> m_detailLevelCounter;
 	std::shared_ptr<Counter> m_speedCounter;
 	std::shared_ptr<Counter> m_distanceCounter;
 	std::shared_ptr<Counter> m_heightCounter;
@@ -27,7 +27,11 @@
 
 #include "nanaka/gui/Panel.h"
 
-TriggerHUD::TriggerHUD(std::shared_ptr<Panel> container)
+#include "gui/WidgetArena.h"
+
+TriggerHUD::TriggerHUD(
+	std::shared_ptr<Panel> container,
+	std::shared_ptr<WidgetArena> widgetArena)
 	: m_first(NoneTriggerHUDIndicator)
 	, m_second(NoneTriggerHUDIndicator)
 	, m_third(NoneTriggerHUDIndicator)
@@ -40,9 +44,9 @@ TriggerHUD::TriggerHUD(std::shared_ptr<Panel> container)
 		LayoutMethod::Linear, LayoutMethod::Horizontal,
 		LayoutMethod::Left, LayoutMethod::VCenter));
 
-	auto leftSpacerPanel = std::make_shared<Panel>();
-	m_indicators = std::make_shared<Panel>();
-	auto rightSpacerPanel = std::make_shared<Panel>();
+	auto leftSpacerPanel = MakeWidget<Panel>(widgetArena);
+	m_indicators = MakeWidget<Panel>(widgetArena);
+	auto rightSpacerPanel = MakeWidget<Panel>(widgetArena);
 
 	container->AddWidget(leftSpacerPanel);
 	container->AddWidget(m_indicators);
@@ -57,19 +61,19 @@ TriggerHUD::TriggerHUD(std::shared_ptr<Panel> container)
 		LayoutMethod::Linear, LayoutMethod::Horizontal,
 		LayoutMethod::Left, LayoutMethod::Top));
 
-	m_boost30Panel = std::make_shared<Panel>();
+	m_boost30Panel = MakeWidget<Panel>(widgetArena);
 	m_boost30Panel->SetBackground("GUI/HUD/Boost30Indicator.png", Vec4f(1.0f));
-	m_boost45Panel = std::make_shared<Panel>();
+	m_boost45Panel = MakeWidget<Panel>(widgetArena);
 	m_boost45Panel->SetBackground("GUI/HUD/Boost45Indicator.png", Vec4f(1.0f));
-	m_boost60Panel = std::make_shared<Panel>();
+	m_boost60Panel = MakeWidget<Panel>(widgetArena);
 	m_boost60Panel->SetBackground("GUI/HUD/Boost60Indicator.png", Vec4f(1.0f));
-	m_slowPanel = std::make_shared<Panel>();
+	m_slowPanel = MakeWidget<Panel>(widgetArena);
 	m_slowPanel->SetBackground("GUI/HUD/SlowIndicator.png", Vec4f(1.0f));
-	m_anglePanel = std::make_shared<Panel>();
+	m_anglePanel = MakeWidget<Panel>(widgetArena);
 	m_anglePanel->SetBackground("GUI/HUD/AngleIndicator.png", Vec4f(1.0f));
-	m_stopPanel = std::make_shared<Panel>();
+	m_stopPanel = MakeWidget<Panel>(widgetArena);
 	m_stopPanel->SetBackground("GUI/HUD/StopIndicator.png", Vec4f(1.0f));
-	m_blockPanel = std::make_shared<Panel>();
+	m_blockPanel = MakeWidget<Panel>(widgetArena);
 	m_blockPanel->SetBackground("GUI/HUD/BlockIndicator.png", Vec4f(1.0f));
 }
 
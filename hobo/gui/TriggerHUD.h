@@ -29,6 +29,7 @@
 #include <memory>
 
 class Panel;
+class WidgetArena;
 
 enum TriggerHUDIndicator
 {
@@ -46,7 +47,9 @@ class TriggerHUD final
 {
 public:
 
-	TriggerHUD(std::shared_ptr<Panel> container);
+	TriggerHUD(
+		std::shared_ptr<Panel> container,
+		std::shared_ptr<WidgetArena> widgetArena);
 
 	void SetIndicators(
 		TriggerHUDIndicator first,
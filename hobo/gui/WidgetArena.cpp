@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gui/WidgetArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+const size_t WidgetArena::s_blockSize;
+
+WidgetArena::WidgetArena()
+	: m_cursor(NULL)
+	, m_left(0)
+{
+}
+
+WidgetArena::~WidgetArena()
+{
+	for (auto block : m_blocks)
+	{
+		delete[] block;
+	}
+}
+
+void* WidgetArena::Allocate(size_t size, size_t alignment)
+{
+	size_t padding = (alignment
+		- reinterpret_cast<uintptr_t>(m_cursor) % alignment) % alignment;
+
+	if (padding + size > m_left)
+	{
+		// Anything that does not fit in a fresh block gets a block of its
+		// own, new[] returns memory aligned for any fundamental type.
+		const size_t blockSize = std::max(size, s_blockSize);
+		m_blocks.push_back(new char[blockSize]);
+		m_cursor = m_blocks.back();
+		m_left = blockSize;
+		padding = 0;
+	}
+
+	void* p = m_cursor + padding;
+	m_cursor += padding + size;
+	m_left -= padding + size;
+	return p;
+}
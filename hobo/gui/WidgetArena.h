@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_GUI_WIDGETARENA_H
+#define HOBO_GUI_WIDGETARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Bump allocator for the widgets of one view. A view builds its widget tree
+ * in one go and keeps it until torn down, so the widgets are placed next to
+ * each other and their memory is only returned all at once, when the arena
+ * is destroyed. Not thread safe, views are built on the game thread.
+ */
+class WidgetArena final
+{
+public:
+
+	WidgetArena();
+	~WidgetArena();
+
+	WidgetArena(const WidgetArena&) = delete;
+	WidgetArena& operator=(const WidgetArena&) = delete;
+
+	void* Allocate(size_t size, size_t alignment);
+
+private:
+
+	static const size_t s_blockSize = 16 * 1024;
+
+	std::vector<char*> m_blocks;
+	char* m_cursor;
+	size_t m_left;
+};
+
+/**
+ * Standard allocator handing out arena memory. Each widget's control block
+ * keeps a copy, so the arena lives until the last widget from it is gone,
+ * even if the GUI holds on to widgets after their view.
+ */
+template<typename T>
+class WidgetAllocator final
+{
+public:
+
+	typedef T value_type;
+
+	WidgetAllocator(std::shared_ptr<WidgetArena> arena);
+
+	template<typename U>
+	WidgetAllocator(const WidgetAllocator<U>& other);
+
+	T* allocate(size_t n);
+	void deallocate(T* p, size_t n);
+
+	std::shared_ptr<WidgetArena> m_arena;
+};
+
+/**
+ * Like std::make_shared, but allocates the widget from the arena.
+ */
+template<typename T, typename... Args>
+std::shared_ptr<T> MakeWidget(
+	const std::shared_ptr<WidgetArena>& arena,
+	Args&&... args);
+
+template<typename T>
+inline WidgetAllocator<T>::WidgetAllocator(std::shared_ptr<WidgetArena> arena)
+	: m_arena(std::move(arena))
+{
+}
+
+template<typename T>
+template<typename U>
+inline WidgetAllocator<T>::WidgetAllocator(const WidgetAllocator<U>& other)
+	: m_arena(other.m_arena)
+{
+}
+
+template<typename T>
+inline T* WidgetAllocator<T>::allocate(size_t n)
+{
+	return static_cast<T*>(m_arena->Allocate(sizeof(T) * n, alignof(T)));
+}
+
+template<typename T>
+inline void WidgetAllocator<T>::deallocate(T* p, size_t n)
+{
+	// Returned with the rest of the arena.
+}
+
+template<typename T, typename U>
+inline bool operator==(
+	const WidgetAllocator<T>& a,
+	const WidgetAllocator<U>& b)
+{
+	return a.m_arena == b.m_arena;
+}
+
+template<typename T, typename U>
+inline bool operator!=(
+	const WidgetAllocator<T>& a,
+	const WidgetAllocator<U>& b)
+{
+	return a.m_arena != b.m_arena;
+}
+
+template<typename T, typename... Args>
+inline std::shared_ptr<T> MakeWidget(
+	const std::shared_ptr<WidgetArena>& arena,
+	Args&&... args)
+{
+	return std::allocate_shared<T>(
+		WidgetAllocator<T>(arena), std::forward<Args>(args)...);
+}
+
+#endif // HOBO_GUI_WIDGETARENA_H
@@ -40,8 +40,11 @@ void CameraObject::Update(Time& time)
 
 	position.z = viewHeight * 0.5f;
 
-	m_camera->SetViewDimensions(Vec2f(viewWidth, viewHeight));
-	m_camera->SetPosition(position);
+	m_viewPosition = position;
+	m_viewDimensions = Vec2f(viewWidth, viewHeight);
+
+	m_camera->SetViewDimensions(m_viewDimensions);
+	m_camera->SetPosition(m_viewPosition);
 }
 
 void CameraObject::SetRenderTarget(
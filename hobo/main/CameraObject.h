@@ -43,8 +43,23 @@ public:
 	float GetMaxViewWidth() const;
 	float GetMaxViewHeight() const;
 
+	Vec3f GetViewPosition() const;
+	Vec2f GetViewDimensions() const;
+
 	void SetRenderTarget(std::shared_ptr<RenderTargetPanel> renderTarget);
 
+	/**
+	 * Overrides the view until the next update, e.g. for presenting a state
+	 * interpolated between two updates.
+	 */
+	void SetView(Vec3f position, Vec2f dimensions);
+
+	/**
+	 * Moves the view back along x by offset along with the entity it follows,
+	 * which only takes effect on the next update otherwise.
+	 */
+	void ShiftOrigin(float offset);
+
 	/**
 	 * GameObject implementation.
 	 */
@@ -57,12 +72,16 @@ private:
 	static const int s_startStretchHeight = 4;
 
 	std::unique_ptr<Camera> m_camera;
+	Vec3f m_viewPosition;
+	Vec2f m_viewDimensions;
 
 	std::shared_ptr<RenderTargetPanel> m_renderTarget;
 };
 
 inline CameraObject::CameraObject()
 	: m_camera(std::unique_ptr<Camera>(new Camera()))
+	, m_viewPosition(Vec3f::Zero())
+	, m_viewDimensions(Vec2f::Zero())
 {
 }
 
@@ -81,4 +100,26 @@ inline float CameraObject::GetMaxViewHeight() const
 	return s_maxViewHeight;
 }
 
+inline void CameraObject::SetView(Vec3f position, Vec2f dimensions)
+{
+	m_camera->SetViewDimensions(dimensions);
+	m_camera->SetPosition(position);
+}
+
+inline void CameraObject::ShiftOrigin(float offset)
+{
+	m_viewPosition.x -= offset;
+	m_camera->SetPosition(m_viewPosition);
+}
+
+inline Vec3f CameraObject::GetViewPosition() const
+{
+	return m_viewPosition;
+}
+
+inline Vec2f CameraObject::GetViewDimensions() const
+{
+	return m_viewDimensions;
+}
+
 #endif // HOBO_MAIN_CAMERAOBJECT_H
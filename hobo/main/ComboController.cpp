@@ -30,14 +30,19 @@
 #include "nanaka/main/World.h"
 #include "nanaka/utils/Time.h"
 
-#include "gui/ComboHUD.h"
+#include "main/RenderSnapshot.h"
+#include "main/SimulationState.h"
+#include "main/StateHash.h"
 #include "main/TimeController.h"
+#include "main/Tunables.h"
 
-const float ComboController::s_timeToExecute = 700.0f;
 const float ComboController::s_timeMaxScore = 500.0f;
 
-ComboController::ComboController(TimeController& timeController)
+ComboController::ComboController(
+	TimeController& timeController,
+	const Tunables& tunables)
 	: m_timeController(timeController)
+	, m_tunables(tunables)
 {
 	Reset();
 }
@@ -47,7 +52,7 @@ void ComboController::Reset()
 	m_visibleTriggers.clear();
 
 	m_comboActive = false;
-	m_executionTimer = 0;
+	m_executionTimer = 0.0f;
 
 	m_lastHitGround = false;
 	m_lastTriggerHitBoost30 = false;
@@ -127,11 +132,11 @@ void ComboController::SetPlayerHasPass(bool hasPass)
 	UpdateAvailableCombos();
 }
 
-void ComboController::Update(unsigned int realTickLength)
+void ComboController::Update(float realStepLength)
 {
 	if (IsComboActivated())
 	{
-		m_executionTimer -= realTickLength;
+		m_executionTimer -= realStepLength;
 
 		if (m_executionTimer <= 0)
 		{
@@ -228,21 +233,81 @@ void ComboController::TryActivateCombo(ComboType comboType)
 void ComboController::ActivateCombo(ComboType comboType)
 {
 	m_timeController.Freeze();
-	m_executionTimer = s_timeToExecute;
+	m_executionTimer = m_tunables.m_comboTimeToExecute;
 	m_activeComboType = comboType;
 	m_comboActive = true;
 }
 
-void ComboController::UpdateComboHUD(ComboHUD& comboHUD) const
+void ComboController::FillRenderSnapshot(RenderSnapshot& snapshot) const
 {
-	comboHUD.SetComboAvailability(
-		m_availableCombos[ComboTypeStop],
-		m_availableCombos[ComboTypeBoost30],
-		m_availableCombos[ComboTypeBoost45],
-		m_availableCombos[ComboTypeBoost60],
-		m_availableCombos[ComboTypeBlock45],
-		m_availableCombos[ComboTypeBlock60],
-		m_playerHasPass);
-	comboHUD.SetComboActive(
-		IsComboActivated(), m_executionTimer / s_timeToExecute);
+	snapshot.m_availableCombos = m_availableCombos;
+	snapshot.m_playerHasPass = m_playerHasPass;
+	snapshot.m_comboActive = IsComboActivated();
+	snapshot.m_comboTimeLeft =
+		m_executionTimer / m_tunables.m_comboTimeToExecute;
+}
+
+void ComboController::HashState(StateHash& hash) const
+{
+	for (auto available : m_availableCombos)
+	{
+		hash.Add(available);
+	}
+
+	for (auto triggerType : m_visibleTriggers)
+	{
+		hash.Add(triggerType);
+	}
+
+	hash.Add(m_lastHitGround);
+	hash.Add(m_lastTriggerHitBoost30);
+	hash.Add(m_lastTriggerHitBoost);
+	hash.Add(m_playerHasPass);
+	hash.Add(m_executionTimer);
+	hash.Add(m_comboActive);
+
+	// The active combo is left as is when it ends.
+	if (m_comboActive)
+	{
+		hash.Add(m_activeComboType);
+		hash.Add(m_activeTrigger->GetType());
+	}
+}
+
+void ComboController::SaveState(SimulationState& state) const
+{
+	state.m_availableCombos = m_availableCombos;
+	state.m_visibleTriggers = m_visibleTriggers;
+	state.m_lastHitGround = m_lastHitGround;
+	state.m_lastTriggerHitBoost30 = m_lastTriggerHitBoost30;
+	state.m_lastTriggerHitBoost = m_lastTriggerHitBoost;
+	state.m_playerHasPass = m_playerHasPass;
+	state.m_executionTimer = m_executionTimer;
+	state.m_comboActive = m_comboActive;
+
+	if (m_comboActive)
+	{
+		state.m_activeComboType = m_activeComboType;
+		state.m_activeTriggerType = m_activeTrigger->GetType();
+	}
+}
+
+void ComboController::RestoreState(
+	const SimulationState& state,
+	Trigger* activeTrigger)
+{
+	m_availableCombos = state.m_availableCombos;
+	m_visibleTriggers = state.m_visibleTriggers;
+	m_lastHitGround = state.m_lastHitGround;
+	m_lastTriggerHitBoost30 = state.m_lastTriggerHitBoost30;
+	m_lastTriggerHitBoost = state.m_lastTriggerHitBoost;
+	m_playerHasPass = state.m_playerHasPass;
+	m_executionTimer = state.m_executionTimer;
+	m_comboActive = state.m_comboActive;
+
+	if (m_comboActive)
+	{
+		m_activeComboType = state.m_activeComboType;
+		m_activeTrigger = activeTrigger;
+	}
 }
@@ -31,8 +31,11 @@
 
 #include "main/Trigger.h"
 
-class ComboHUD;
+class StateHash;
 class TimeController;
+struct RenderSnapshot;
+struct SimulationState;
+struct Tunables;
 
 enum ComboType
 {
@@ -49,11 +52,17 @@ class ComboController final
 {
 public:
 
-	ComboController(TimeController& timeController);
+	ComboController(
+		TimeController& timeController,
+		const Tunables& tunables);
 
 	void Reset();
-	void Update(unsigned int realTickLength);
-	void UpdateComboHUD(ComboHUD& comboHUD) const;
+	void Update(float realStepLength);
+	void FillRenderSnapshot(RenderSnapshot& snapshot) const;
+	void HashState(StateHash& hash) const;
+
+	void SaveState(SimulationState& state) const;
+	void RestoreState(const SimulationState& state, Trigger* activeTrigger);
 
 	void TriggerAppeared(TriggerType triggerType);
 	void TriggerHit(TriggerType triggerType);
@@ -73,7 +82,6 @@ private:
 	float CalculateScore() const;
 
 	static const float s_timeMaxScore;
-	static const float s_timeToExecute;
 	static const size_t s_maxTriggers = 3;
 
 	std::array<bool, ComboTypeNum> m_availableCombos;
@@ -84,13 +92,14 @@ private:
 	bool m_lastTriggerHitBoost;
 	bool m_playerHasPass;
 
-	int m_executionTimer;
+	float m_executionTimer;
 
 	bool m_comboActive;
 	ComboType m_activeComboType;
 	Trigger* m_activeTrigger;
 
 	TimeController& m_timeController;
+	const Tunables& m_tunables;
 };
 
 inline float ComboController::CalculateScore() const
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "main/DetailController.h"
+
+#include <algorithm>
+
+const float DetailController::s_maxFrameScale = 4.0f;
+const float DetailController::s_smoothing = 0.1f;
+const float DetailController::s_lowerThreshold = 1.15f;
+const float DetailController::s_raiseThreshold = 0.75f;
+
+DetailController::DetailController(float targetFrameLength, int maxLevel)
+	: m_targetFrameLength(targetFrameLength)
+	, m_maxLevel(maxLevel)
+	, m_level(0)
+{
+	Reset();
+}
+
+bool DetailController::FrameFinished(float frameLength)
+{
+	// A single hitch, like the first frame after loading, should not count
+	// for more than a few slow frames.
+	frameLength = std::min(frameLength, m_targetFrameLength * s_maxFrameScale);
+	m_averageFrameLength +=
+		(frameLength - m_averageFrameLength) * s_smoothing;
+
+	// Count consecutive frames on either side, lowering quickly but raising
+	// slowly so a level that barely keeps up is not toggled back and forth.
+	if (m_averageFrameLength > m_targetFrameLength * s_lowerThreshold)
+	{
+		++m_framesAbove;
+		m_framesBelow = 0;
+	}
+	else if (m_averageFrameLength < m_targetFrameLength * s_raiseThreshold)
+	{
+		++m_framesBelow;
+		m_framesAbove = 0;
+	}
+	else
+	{
+		m_framesAbove = 0;
+		m_framesBelow = 0;
+	}
+
+	const int level = m_level;
+	if (m_framesAbove >= s_lowerFrames && m_level < m_maxLevel)
+	{
+		++m_level;
+	}
+	else if (m_framesBelow >= s_raiseFrames && m_level > 0)
+	{
+		--m_level;
+	}
+
+	if (m_level != level)
+	{
+		m_framesAbove = 0;
+		m_framesBelow = 0;
+		return true;
+	}
+
+	return false;
+}
+
+void DetailController::Reset()
+{
+	m_averageFrameLength = m_targetFrameLength;
+	m_framesAbove = 0;
+	m_framesBelow = 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_DETAILCONTROLLER_H
+#define HOBO_MAIN_DETAILCONTROLLER_H
+
+/**
+ * Trades visual detail for frame time. Frame lengths are smoothed, and the
+ * detail level is lowered when they stay above the target and raised again
+ * when they stay well below it. Level 0 is full detail.
+ *
+ * The frame length is measured on the CPU from frame start to frame start,
+ * which includes waiting for the GPU in the buffer swap.
+ */
+class DetailController final
+{
+public:
+
+	DetailController(float targetFrameLength, int maxLevel);
+
+	/**
+	 * Returns true if the detail level changed.
+	 */
+	bool FrameFinished(float frameLength);
+
+	/**
+	 * Frames after e.g. a pause are not representative, start over.
+	 */
+	void Reset();
+
+	int GetLevel() const;
+	float GetAverageFrameLength() const;
+
+private:
+
+	static const float s_maxFrameScale;
+	static const float s_smoothing;
+	static const float s_lowerThreshold;
+	static const float s_raiseThreshold;
+	static const int s_lowerFrames = 30;
+	static const int s_raiseFrames = 180;
+
+	float m_targetFrameLength;
+	int m_maxLevel;
+
+	int m_level;
+	float m_averageFrameLength;
+	int m_framesAbove;
+	int m_framesBelow;
+};
+
+inline int DetailController::GetLevel() const
+{
+	return m_level;
+}
+
+inline float DetailController::GetAverageFrameLength() const
+{
+	return m_averageFrameLength;
+}
+
+#endif // HOBO_MAIN_DETAILCONTROLLER_H
@@ -32,5 +32,6 @@ static const EntityTypeName BillboardEntityType = 0;
 static const EntityTypeName CameraEntityType = 1;
 static const EntityTypeName PlayerEntityType = 2;
 static const EntityTypeName TriggerEntityType = 3;
+static const EntityTypeName PlayerSpriteEntityType = 4;
 
 #endif // HOBO_MAIN_ENTITYTYPES_H
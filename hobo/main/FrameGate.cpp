@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "main/FrameGate.h"
+
+FrameGate::FrameGate()
+	: m_lockstep(false)
+	, m_numFrames(0)
+	, m_numFramesRun(0)
+{
+}
+
+#if defined(SINGLE_THREADED)
+
+void FrameGate::SetLockstep(bool lockstep)
+{
+	m_lockstep = lockstep;
+}
+
+bool FrameGate::IsLockstep() const
+{
+	return m_lockstep;
+}
+
+void FrameGate::FrameBegin()
+{
+}
+
+void FrameGate::FrameEnd()
+{
+	++m_numFrames;
+}
+
+void FrameGate::RunFrame()
+{
+	++m_numFramesRun;
+}
+
+unsigned int FrameGate::GetNumFrames() const
+{
+	return m_numFrames;
+}
+
+#else
+
+void FrameGate::SetLockstep(bool lockstep)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_lockstep = lockstep;
+		m_numFramesRun = m_numFrames;
+	}
+	m_condition.notify_all();
+}
+
+bool FrameGate::IsLockstep() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_lockstep;
+}
+
+void FrameGate::FrameBegin()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this]()
+	{
+		return !m_lockstep || m_numFramesRun > m_numFrames;
+	});
+}
+
+void FrameGate::FrameEnd()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_numFrames;
+	}
+	m_condition.notify_all();
+}
+
+void FrameGate::RunFrame()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	const unsigned int frame = ++m_numFramesRun;
+	m_condition.notify_all();
+	m_condition.wait(lock, [this, frame]()
+	{
+		return !m_lockstep || m_numFrames >= frame;
+	});
+}
+
+unsigned int FrameGate::GetNumFrames() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_numFrames;
+}
+
+#endif // defined(SINGLE_THREADED)
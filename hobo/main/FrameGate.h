@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_FRAMEGATE_H
+#define HOBO_MAIN_FRAMEGATE_H
+
+#if !defined(SINGLE_THREADED)
+#include <condition_variable>
+#include <mutex>
+#endif // !defined(SINGLE_THREADED)
+
+/**
+ * Counts the frames of Main::GameLoop, and lets a platform run them one at a
+ * time to replay input on exact frames. In lockstep, every frame waits in
+ * FrameBegin until the platform runs it with RunFrame. Otherwise frames run
+ * freely and are only counted.
+ *
+ * Single threaded platforms run the game loop themselves, so nothing waits
+ * there and RunFrame only lets the next frame through.
+ */
+class FrameGate final
+{
+public:
+
+	FrameGate();
+
+	/**
+	 * Leaving lockstep lets a frame waiting to be run through, which the
+	 * platform has to do before stopping the engine thread.
+	 */
+	void SetLockstep(bool lockstep);
+	bool IsLockstep() const;
+
+	/**
+	 * Called by the game around every frame.
+	 */
+	void FrameBegin();
+	void FrameEnd();
+
+	/**
+	 * Called by the platform in lockstep, returns once the frame has ended.
+	 */
+	void RunFrame();
+
+	/**
+	 * The number of frames that have ended.
+	 */
+	unsigned int GetNumFrames() const;
+
+private:
+
+	bool m_lockstep;
+	unsigned int m_numFrames;
+	unsigned int m_numFramesRun;
+
+#if !defined(SINGLE_THREADED)
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+#endif // !defined(SINGLE_THREADED)
+};
+
+#endif // HOBO_MAIN_FRAMEGATE_H
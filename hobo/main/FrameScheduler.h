@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_FRAMESCHEDULER_H
+#define HOBO_MAIN_FRAMESCHEDULER_H
+
+#include <chrono>
+
+/**
+ * Decides which frames are worth rendering. A frame is due whenever
+ * something has been invalidated, and while animating also when the minimum
+ * frame length has passed since the last rendered frame. Render targets keep
+ * their contents in between, so skipped frames just show the last one.
+ */
+class FrameScheduler final
+{
+public:
+
+	FrameScheduler(float minFrameLength);
+
+	void Invalidate();
+	void SetAnimating(bool animating);
+
+	bool IsFrameDue();
+
+private:
+
+	typedef std::chrono::steady_clock Clock;
+
+	Clock::duration m_minFrameLength;
+	Clock::time_point m_lastFrameTime;
+
+	bool m_dirty;
+	bool m_animating;
+};
+
+inline void FrameScheduler::Invalidate()
+{
+	m_dirty = true;
+}
+
+inline void FrameScheduler::SetAnimating(bool animating)
+{
+	m_animating = animating;
+}
+
+#endif // HOBO_MAIN_FRAMESCHEDULER_H
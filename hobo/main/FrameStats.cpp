@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "main/FrameStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+typedef std::chrono::duration<float, std::milli> FloatMs;
+
+static float Percentile(std::vector<float> values, float percentile)
+{
+	if (values.empty())
+	{
+		return 0.0f;
+	}
+	const size_t idx = std::min(values.size() - 1,
+		static_cast<size_t>(values.size() * percentile));
+	std::nth_element(values.begin(), values.begin() + idx, values.end());
+	return values[idx];
+}
+
+static float Mean(const std::vector<float>& values)
+{
+	float sum = 0.0f;
+	for (auto value : values)
+	{
+		sum += value;
+	}
+	return values.empty() ? 0.0f : sum / values.size();
+}
+
+FrameStats::FrameStats(size_t (*allocationCounter)())
+	: m_allocationCounter(allocationCounter)
+	, m_allocationsBefore(0)
+{
+	// Keep the collection itself from allocating during the run.
+	m_frames.reserve(s_reservedFrames);
+}
+
+void FrameStats::FrameBegin()
+{
+	m_frameBegin = Clock::now();
+	if (m_allocationCounter)
+	{
+		m_allocationsBefore = m_allocationCounter();
+	}
+}
+
+void FrameStats::UpdateEnd()
+{
+	m_updateEnd = Clock::now();
+}
+
+void FrameStats::FrameEnd()
+{
+	const auto now = Clock::now();
+
+	Frame frame;
+	frame.m_updateMs = FloatMs(m_updateEnd - m_frameBegin).count();
+	frame.m_drawMs = FloatMs(now - m_updateEnd).count();
+	frame.m_frameMs = m_frames.empty()
+		? 0.0f : FloatMs(m_frameBegin - m_lastFrameBegin).count();
+	frame.m_allocations = m_allocationCounter
+		? m_allocationCounter() - m_allocationsBefore : 0;
+	m_frames.push_back(frame);
+
+	m_lastFrameBegin = m_frameBegin;
+}
+
+FrameStats::Metrics FrameStats::Summarize() const
+{
+	std::vector<float> updateMs;
+	std::vector<float> drawMs;
+	std::vector<float> frameMs;
+	std::vector<float> allocations;
+
+	// The first frame has no frame time, it includes loading everything.
+	for (size_t i = 1; i < m_frames.size(); ++i)
+	{
+		updateMs.push_back(m_frames[i].m_updateMs);
+		drawMs.push_back(m_frames[i].m_drawMs);
+		frameMs.push_back(m_frames[i].m_frameMs);
+		allocations.push_back(m_frames[i].m_allocations);
+	}
+
+	Metrics metrics;
+	metrics["updateMsMean"] = Mean(updateMs);
+	metrics["updateMsP95"] = Percentile(updateMs, 0.95f);
+	metrics["drawMsMean"] = Mean(drawMs);
+	metrics["drawMsP95"] = Percentile(drawMs, 0.95f);
+	metrics["frameMsMean"] = Mean(frameMs);
+	metrics["frameMsP50"] = Percentile(frameMs, 0.5f);
+	metrics["frameMsP95"] = Percentile(frameMs, 0.95f);
+	metrics["frameMsP99"] = Percentile(frameMs, 0.99f);
+	metrics["frameMsMax"] = Percentile(frameMs, 1.0f);
+	metrics["allocationsPerFrame"] = Mean(allocations);
+	return metrics;
+}
+
+bool FrameStats::WriteReport(const std::string& filePath) const
+{
+	FILE* file = fopen(filePath.c_str(), "w");
+	if (!file)
+	{
+		return false;
+	}
+
+	const auto metrics = Summarize();
+
+	fprintf(file, "{\n  \"frames\": %zu", m_frames.size());
+	for (const auto& metric : metrics)
+	{
+		fprintf(file, ",\n  \"%s\": %.3f",
+			metric.first.c_str(), metric.second);
+	}
+	fprintf(file, "\n}\n");
+
+	return fclose(file) == 0;
+}
+
+bool FrameStats::CompareToBaseline(
+	const std::string& filePath,
+	float tolerance) const
+{
+	std::ifstream file(filePath);
+	if (!file)
+	{
+		printf("Could not read baseline %s.\n", filePath.c_str());
+		return false;
+	}
+
+	const std::string json((std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>());
+
+	bool success = true;
+
+	printf("%-24s %10s %10s\n", "metric", "value", "baseline");
+	for (const auto& metric : Summarize())
+	{
+		// Reports are flat objects of "name": number pairs.
+		const size_t namePos = json.find("\"" + metric.first + "\"");
+		const size_t colonPos = json.find(':', namePos);
+		if (namePos == std::string::npos || colonPos == std::string::npos)
+		{
+			printf("%-24s %10.3f %10s\n",
+				metric.first.c_str(), metric.second, "new");
+			continue;
+		}
+
+		const float baseline = strtof(json.c_str() + colonPos + 1, NULL);
+		const bool worse = metric.second > baseline * (1.0f + tolerance)
+			+ 0.01f;
+
+		printf("%-24s %10.3f %10.3f%s\n", metric.first.c_str(),
+			metric.second, baseline, worse ? " WORSE" : "");
+
+		success = success && !worse;
+	}
+
+	return success;
+}
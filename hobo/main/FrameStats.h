@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_FRAMESTATS_H
+#define HOBO_MAIN_FRAMESTATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Collects CPU time spent per frame in Main::GameLoop, for end-to-end frame
+ * time benchmarks. Time spent outside the game loop, e.g. in the buffer swap,
+ * is included in the frame time but not in the update or draw times.
+ */
+class FrameStats final
+{
+public:
+
+	/**
+	 * The allocation counter is optional, pass NULL to not count allocations.
+	 */
+	FrameStats(size_t (*allocationCounter)());
+
+	void FrameBegin();
+	void UpdateEnd();
+	void FrameEnd();
+
+	bool WriteReport(const std::string& filePath) const;
+
+	/**
+	 * Returns false if any metric is more than tolerance worse than in the
+	 * baseline, which is a report written by an earlier run.
+	 */
+	bool CompareToBaseline(const std::string& filePath, float tolerance) const;
+
+private:
+
+	typedef std::chrono::steady_clock Clock;
+	typedef std::map<std::string, float> Metrics;
+
+	struct Frame
+	{
+		float m_updateMs;
+		float m_drawMs;
+		float m_frameMs;
+		size_t m_allocations;
+	};
+
+	static const size_t s_reservedFrames = 1 << 16;
+
+	Metrics Summarize() const;
+
+	size_t (*m_allocationCounter)();
+
+	std::vector<Frame> m_frames;
+
+	Clock::time_point m_frameBegin;
+	Clock::time_point m_updateEnd;
+	Clock::time_point m_lastFrameBegin;
+	size_t m_allocationsBefore;
+};
+
+#endif // HOBO_MAIN_FRAMESTATS_H
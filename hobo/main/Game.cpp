@@ -30,16 +30,71 @@
 #include "nanaka/game/GameEM.h"
 #include "nanaka/gui/RenderTargetPanel.h"
 #include "nanaka/main/INanaka.h"
+#include "nanaka/math/Quat.h"
+
+#include <algorithm>
 
 #include "main/EntityTypes.h"
+#include "main/HighscoreStore.h"
 #include "main/Player.h"
 #include "main/PlayerET.h"
+#include "main/PlayerSpriteET.h"
+#include "main/RunSeeds.h"
+
+const float Game::s_targetFrameLength = 1000.0f / 60.0f;
+
+// Dropped in this order as the detail level is lowered.
+static const std::vector<LayerType> s_optionalLayerTypes = {
+	CloudsLayerType,
+	Hills2LayerType,
+	Hills1LayerType,
+};
+
+static Vec3f Lerp(const Vec3f& from, const Vec3f& to, float alpha)
+{
+	return from * (1.0f - alpha) + to * alpha;
+}
+
+static Vec2f Lerp(const Vec2f& from, const Vec2f& to, float alpha)
+{
+	return from * (1.0f - alpha) + to * alpha;
+}
+
+// Turns the short way round, so a spin wrapping past a full turn between
+// two steps does not spin back. About a fixed axis this is a slerp.
+static float LerpAngle(float from, float to, float alpha)
+{
+	const float turn = 3.142f * 2;
+	float delta = to - from;
+	if (delta > turn * 0.5f)
+	{
+		delta -= turn;
+	}
+	else if (delta < -turn * 0.5f)
+	{
+		delta += turn;
+	}
+	return from + delta * alpha;
+}
 
-Game::Game(INanaka* nanaka, std::unique_ptr<GameView> gameView)
+Game::Game(
+	INanaka* nanaka,
+	std::unique_ptr<GameView> gameView,
+	RunSeeds& runSeeds,
+	HighscoreStore* highscoreStore)
 	: m_nanaka(nanaka)
 	, m_world(std::make_shared<World>())
 	, m_gameView(std::move(gameView))
-	, m_sound("Sounds/loop.ogg")
+	, m_lastFrameTime(std::chrono::steady_clock::now())
+	, m_fixedFrameLength(0.0f)
+	, m_simAccumulator(0.0f)
+	, m_resetInterpolation(true)
+	, m_runSeeds(runSeeds)
+	, m_highscoreStore(highscoreStore)
+	, m_seed(0)
+	, m_runRecorded(true)
+	, m_frameScheduler(0.0f)
+	, m_detailController(s_targetFrameLength, s_optionalLayerTypes.size())
 {
 	m_gameView->SetClient(this);
 	m_gameView->GetRenderPanel()->SetRenderTargetPanelListener(this);
@@ -49,16 +104,21 @@ Game::Game(INanaka* nanaka, std::unique_ptr<GameView> gameView)
 		m_nanaka->GetEntitySystem().GetEntityTypeId(PlayerEntityType), true);
 
 	m_timeController = std::unique_ptr<TimeController>(
-		new TimeController(m_world->GetTime()));
+		new TimeController());
 
 	m_comboController = std::unique_ptr<ComboController>(
-		new ComboController(*m_timeController));
+		new ComboController(*m_timeController, m_tunables));
 
-	PlayerEMParams playerParams(*m_comboController, *m_timeController);
+	PlayerEMParams playerParams(
+		*m_comboController, *m_timeController, m_tunables);
 	auto playerEntity = nanaka->GetEntitySystem().SpawnEntity(
 		PlayerEntityType, &playerParams, &m_world->GetEntityTree());
 	m_player = &playerEntity->GetModule<GameEM>()->GetGameObject<Player>();
 
+	m_playerSprite = nanaka->GetEntitySystem().SpawnEntity(
+		PlayerSpriteEntityType, NULL, &m_world->GetEntityTree());
+	m_player->SetSprite(m_playerSprite->GetModule<SceneEM>());
+
 	auto cameraEntity =
 		nanaka->GetEntitySystem().SpawnEntity(CameraEntityType, NULL);
 	m_camera =
@@ -69,7 +129,13 @@ Game::Game(INanaka* nanaka, std::unique_ptr<GameView> gameView)
 	playerEntity->AttachEntity(cameraEntity);
 
 	m_triggerManager = std::unique_ptr<TriggerManager>(new TriggerManager(
-		m_nanaka, *m_player, *m_timeController, *m_comboController, m_world));
+		m_nanaka,
+		*m_player,
+		*m_timeController,
+		*m_comboController,
+		m_tunables,
+		m_world,
+		true));
 
 	std::vector<LayerType> layerTypes = {
 		GrassLayerType,
@@ -82,68 +148,289 @@ Game::Game(INanaka* nanaka, std::unique_ptr<GameView> gameView)
 	for (auto layerType : layerTypes)
 	{
 		m_layers.push_back(std::unique_ptr<Layer>(
-			new Layer(m_nanaka, *m_camera, m_world, layerType)));
+			new Layer(m_nanaka, *m_camera, m_viewCuller, m_world, layerType)));
+	}
+
+	for (auto layerType : s_optionalLayerTypes)
+	{
+		const auto layerIt =
+			std::find(layerTypes.begin(), layerTypes.end(), layerType);
+		m_optionalLayers.push_back(
+			m_layers[layerIt - layerTypes.begin()].get());
 	}
 
+#if defined(HOBO_LATENCY_PROBE)
+	m_latencyProbe = std::unique_ptr<LatencyProbe>(new LatencyProbe());
+#endif // defined(HOBO_LATENCY_PROBE)
+
 	Restart();
 }
 
+void Game::LoadSound()
+{
+	m_sound = std::unique_ptr<Sound>(new Sound("Sounds/loop.ogg"));
+}
+
 void Game::Update()
 {
+	if (m_latencyProbe)
+	{
+		m_latencyProbe->FrameBegin();
+	}
+
+	const auto frameTime = std::chrono::steady_clock::now();
+	const float frameLength = m_fixedFrameLength > 0.0f
+		? m_fixedFrameLength
+		: std::chrono::duration<float, std::milli>(
+			frameTime - m_lastFrameTime).count();
+	m_lastFrameTime = frameTime;
+
 	switch (m_gameState)
 	{
 	case GameStateRunning:
-		m_world->Tick();
-		UpdateLayers();
-		m_triggerManager->Update(
-			m_player->GetEntity()->GetPosition().x, !m_player->HasPass());
-		m_triggerManager->UpdateTriggerHUD(m_gameView->GetTriggerHUD());
-		m_comboController->Update(m_world->GetTime().GetRealTick());
-		m_comboController->UpdateComboHUD(m_gameView->GetComboHUD());
-		m_timeController->Update();
+		if (m_fixedFrameLength == 0.0f
+			&& m_detailController.FrameFinished(frameLength))
+		{
+			ApplyDetailLevel();
+		}
+
+		// Step the simulation at a fixed rate, carrying the time left over
+		// to the next frame. After a stall only a few steps are caught up,
+		// the rest of the time is dropped.
+		m_simAccumulator = std::min(m_simAccumulator + frameLength,
+			TimeController::s_stepLength * s_maxStepsPerFrame);
+		while (m_simAccumulator >= TimeController::s_stepLength)
+		{
+			m_simAccumulator -= TimeController::s_stepLength;
+			StepSimulation();
+		}
+
+		InterpolateSimulationState(
+			m_simAccumulator / TimeController::s_stepLength);
 		break;
 
 	case GameStatePaused:
+		// The render target keeps the frame captured when pausing.
 		break;
 	}
 
 	if (m_player->IsStopped())
 	{
-		m_sound.Stop();
+		if (m_sound)
+		{
+			m_sound->Stop();
+		}
 		m_gameView->StateTransition(GameViewStateStoped);
+
+		if (!m_runRecorded && m_highscoreStore)
+		{
+			// Replays are not recorded yet, so there is nothing to refer to.
+			m_highscoreStore->Record(m_player->GetDistance(), m_seed, 0);
+		}
+		m_runRecorded = true;
 	}
 
-	m_player->UpdatePlayerHUD(m_gameView->GetPlayerHUD());
+	PresentHUD();
+
+	if (m_latencyProbe)
+	{
+		m_latencyProbe->UpdateFinished();
+		m_gameView->SetLatencyMarkerVisible(m_latencyProbe->IsMarkerFrame());
+	}
+}
+
+void Game::StepSimulation()
+{
+	// The engine time only drives presentation, such as animations, which
+	// should still follow slow motion.
+	m_timeController->Step();
+	m_world->GetTime().SetGameTimeMultiplier(
+		m_timeController->GetGameTimeMultiplier());
+
+	m_world->Tick();
+	m_triggerManager->Update(
+		m_player->GetEntity()->GetPosition().x, !m_player->HasPass());
+	m_comboController->Update(m_timeController->GetRealStep());
+
+	ShiftOrigin();
+	TakeSnapshot();
+}
+
+void Game::ApplyDetailLevel()
+{
+	const size_t level = m_detailController.GetLevel();
+	for (size_t i = 0; i < m_optionalLayers.size(); ++i)
+	{
+		m_optionalLayers[i]->SetEnabled(i >= level);
+	}
+}
+
+void Game::ShiftOrigin()
+{
+	// Keep the world near the origin on long runs, where floats are precise.
+	if (!m_player->IsPastOriginShift())
+	{
+		return;
+	}
+
+	const float offset = Player::s_originShift;
+
+	m_player->ShiftOrigin(offset);
+	m_camera->ShiftOrigin(offset);
+	m_triggerManager->ShiftOrigin(offset);
+
+	for (auto& layer : m_layers)
+	{
+		layer->ShiftOrigin(offset);
+	}
+
+	// The camera follows the player entity, but the snapshots to interpolate
+	// between are still in the old coordinates.
+	for (auto snapshot : {&m_previousSnapshot, &m_snapshot})
+	{
+		snapshot->m_cameraPosition.x -= offset;
+		snapshot->m_playerPosition.x -= offset;
+		snapshot->m_layerScroll -= offset;
+	}
+}
+
+void Game::TakeSnapshot()
+{
+	// The latest snapshot becomes the one to interpolate from.
+	m_previousSnapshot = m_snapshot;
+
+	const float cameraX = m_camera->GetEntity()->GetPosition().x;
+	const float viewWidth = m_camera->GetMaxViewWidth();
+
+	m_snapshot.m_cameraPosition = m_camera->GetViewPosition();
+	m_snapshot.m_cameraViewDimensions = m_camera->GetViewDimensions();
+	m_snapshot.m_layerScroll = cameraX - viewWidth * 0.5f;
+
+	m_player->FillRenderSnapshot(m_snapshot);
+	m_comboController->FillRenderSnapshot(m_snapshot);
+	m_triggerManager->FillRenderSnapshot(m_snapshot);
+
+	// Nothing to interpolate from right after a restart.
+	if (m_resetInterpolation)
+	{
+		m_previousSnapshot = m_snapshot;
+		m_resetInterpolation = false;
+	}
+}
+
+void Game::InterpolateSimulationState(float alpha)
+{
+	// Present the state between the two latest simulation steps, once there
+	// are two steps taken since the last restart.
+	if (m_resetInterpolation)
+	{
+		return;
+	}
+
+	const auto& from = m_previousSnapshot;
+	const auto& to = m_snapshot;
+
+	const Vec3f viewPosition =
+		Lerp(from.m_cameraPosition, to.m_cameraPosition, alpha);
+	const Vec2f viewDimensions =
+		Lerp(from.m_cameraViewDimensions, to.m_cameraViewDimensions, alpha);
+	m_camera->SetView(viewPosition, viewDimensions);
+
+	// The simulated player entity stays where the simulation put it, only
+	// the sprite is placed in between.
+	m_playerSprite->SetPosition(
+		Lerp(from.m_playerPosition, to.m_playerPosition, alpha));
+	m_playerSprite->SetRotation(Quat(Vec3f::UnitY(),
+		LerpAngle(from.m_playerAngle, to.m_playerAngle, alpha)));
+
+	UpdateLayers(
+		from.m_layerScroll * (1.0f - alpha) + to.m_layerScroll * alpha);
+
+	// Cull after the layers are placed for the view being presented.
+	m_viewCuller.Cull(viewPosition, viewDimensions);
+}
+
+void Game::PresentHUD()
+{
+	const auto& snapshot = m_snapshot;
+
+	m_gameView->GetPlayerHUD().Update(
+		snapshot.m_speed,
+		snapshot.m_distance,
+		snapshot.m_soarLoad,
+		snapshot.m_ascentLoad,
+		snapshot.m_height);
+	m_gameView->GetPlayerHUD().SetPerformance(
+		m_detailController.GetAverageFrameLength(),
+		m_detailController.GetLevel());
+
+	m_gameView->GetComboHUD().SetComboAvailability(
+		snapshot.m_availableCombos[ComboTypeStop],
+		snapshot.m_availableCombos[ComboTypeBoost30],
+		snapshot.m_availableCombos[ComboTypeBoost45],
+		snapshot.m_availableCombos[ComboTypeBoost60],
+		snapshot.m_availableCombos[ComboTypeBlock45],
+		snapshot.m_availableCombos[ComboTypeBlock60],
+		snapshot.m_playerHasPass);
+	m_gameView->GetComboHUD().SetComboActive(
+		snapshot.m_comboActive, snapshot.m_comboTimeLeft);
+
+	m_gameView->GetTriggerHUD().SetIndicators(
+		snapshot.m_triggerIndicators[0],
+		snapshot.m_triggerIndicators[1],
+		snapshot.m_triggerIndicators[2]);
+}
+
+void Game::Draw() const
+{
+	m_world->Draw(*m_camera->GetCamera());
+
+	if (m_latencyProbe)
+	{
+		m_latencyProbe->DrawSubmitted();
+	}
 }
 
 void Game::KickOff(float angle, float strength)
 {
-	m_sound.Repeat();
+	if (m_sound)
+	{
+		m_sound->Repeat();
+	}
 	m_player->KickOff(angle, strength);
 	m_triggerManager->KickOff();
+	m_runRecorded = false;
 }
 
 void Game::OnNewSize(UUID panelId)
 {
+	Invalidate();
+
 	for (auto& layer : m_layers)
 	{
 		layer->UpdateViewSize();
 	}
+
+	// Place any new billboards, also when paused and not updating.
+	InterpolateSimulationState(
+		m_simAccumulator / TimeController::s_stepLength);
 }
 
-void Game::UpdateLayers()
+void Game::UpdateLayers(float scroll)
 {
-	const float cameraX = m_camera->GetEntity()->GetPosition().x;
-	const float viewWidth = m_camera->GetMaxViewWidth();
-	const float layerScroll = cameraX - viewWidth * 0.5f;
 	for (auto& layer : m_layers)
 	{
-		layer->SetScroll(layerScroll);
+		layer->SetScroll(scroll);
 	}
 }
 
 void Game::ScreenTouched()
 {
+	if (m_latencyProbe)
+	{
+		m_latencyProbe->InputReceived();
+	}
+
 	if (m_comboController->IsComboActivated())
 	{
 		if (m_player->AddComboScore(m_comboController->ExecuteCombo()))
@@ -159,16 +446,43 @@ void Game::ScreenTouched()
 
 void Game::Pause()
 {
-	m_sound.Pause();
+	if (m_sound)
+	{
+		m_sound->Pause();
+	}
 	m_gameState = GameStatePaused;
+
+	// Capture the paused state in one last frame, the render target then
+	// keeps showing it behind the pause panel until unpaused.
+	m_frameScheduler.SetAnimating(false);
+	m_frameScheduler.Invalidate();
 	m_gameView->StateTransition(GameViewStatePaused);
 }
 
 void Game::Restart()
 {
-	m_sound.Stop();
+	if (m_latencyProbe)
+	{
+		m_latencyProbe->Report();
+	}
+
+	if (m_sound)
+	{
+		m_sound->Stop();
+	}
+
+	// The player is stopped until kicked off, that run is not recorded.
+	m_seed = m_runSeeds.Next();
+	m_runRecorded = true;
+	m_triggerManager->Seed(m_seed);
 	m_triggerManager->Reset(0.0f);
 	m_player->Reset(0.0f);
 	m_comboController->Reset();
+	m_timeController->Reset();
+
+	// Step right away, and do not interpolate from before the restart.
+	m_simAccumulator = TimeController::s_stepLength;
+	m_resetInterpolation = true;
+
 	Unpause();
 }
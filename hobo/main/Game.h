@@ -26,6 +26,7 @@
 #ifndef HOBO_MAIN_GAME_H
 #define HOBO_MAIN_GAME_H
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -36,21 +37,52 @@
 #include "gui/GameView.h"
 #include "main/CameraObject.h"
 #include "main/ComboController.h"
+#include "main/DetailController.h"
+#include "main/FrameScheduler.h"
+#include "main/LatencyProbe.h"
 #include "main/Layer.h"
+#include "main/RenderSnapshot.h"
 #include "main/TimeController.h"
 #include "main/TriggerManager.h"
+#include "main/Tunables.h"
+#include "main/ViewCuller.h"
 
+class Entity;
+class HighscoreStore;
 class INanaka;
 class Player;
+class RunSeeds;
 
 class Game final : public RenderTargetPanelListener, public GameViewClient
 {
 public:
 
-	Game(INanaka* nanaka, std::unique_ptr<GameView> gameView);
+	static const float s_targetFrameLength;
+
+	Game(
+		INanaka* nanaka,
+		std::unique_ptr<GameView> gameView,
+		RunSeeds& runSeeds,
+		HighscoreStore* highscoreStore);
+
+	/**
+	 * The music is loaded apart from the rest of the game, so that building
+	 * the game can be spread over frames. The game is silent until then.
+	 */
+	void LoadSound();
+
+	/**
+	 * Advances the game the given number of milliseconds every frame instead
+	 * of the time since the last frame, and keeps the detail level, so that a
+	 * replay plays out the same every time. Zero goes back to real time.
+	 */
+	void SetFixedFrameLength(float fixedFrameLength);
+
+	void Invalidate();
+	bool IsFrameDue();
 
 	void Update();
-	void UpdateLayers();
+	void UpdateLayers(float scroll);
 	void Draw() const;
 
 	/**
@@ -75,6 +107,15 @@ private:
 		GameStatePaused,
 	};
 
+	static const unsigned int s_maxStepsPerFrame = 5;
+
+	void StepSimulation();
+	void ApplyDetailLevel();
+	void ShiftOrigin();
+	void TakeSnapshot();
+	void InterpolateSimulationState(float alpha);
+	void PresentHUD();
+
 	INanaka* m_nanaka;
 
 	std::shared_ptr<World> m_world;
@@ -84,25 +125,63 @@ private:
 	std::unique_ptr<GameView> m_gameView;
 
 	Player* m_player;
+	std::shared_ptr<Entity> m_playerSprite;
 	CameraObject* m_camera;
 
+	Tunables m_tunables;
+
 	std::unique_ptr<TimeController> m_timeController;
 	std::unique_ptr<ComboController> m_comboController;
 	std::unique_ptr<TriggerManager> m_triggerManager;
+	ViewCuller m_viewCuller;
 	std::vector<std::unique_ptr<Layer>> m_layers;
+	std::vector<Layer*> m_optionalLayers;
+
+	RenderSnapshot m_previousSnapshot;
+	RenderSnapshot m_snapshot;
+
+	std::chrono::steady_clock::time_point m_lastFrameTime;
+	float m_fixedFrameLength;
+	float m_simAccumulator;
+	bool m_resetInterpolation;
+
+	RunSeeds& m_runSeeds;
+	HighscoreStore* m_highscoreStore; // NULL when runs are not recorded.
+	unsigned int m_seed;
+	bool m_runRecorded;
 
-	Sound m_sound;
+	FrameScheduler m_frameScheduler;
+	DetailController m_detailController;
+
+	std::unique_ptr<LatencyProbe> m_latencyProbe;
+
+	std::unique_ptr<Sound> m_sound;
 };
 
-inline void Game::Unpause()
+inline void Game::SetFixedFrameLength(float fixedFrameLength)
 {
-	m_sound.Unpause();
-	m_gameState = GameStateRunning;
+	m_fixedFrameLength = fixedFrameLength;
+}
+
+inline void Game::Invalidate()
+{
+	m_frameScheduler.Invalidate();
 }
 
-inline void Game::Draw() const
+inline bool Game::IsFrameDue()
 {
-	m_world->Draw(*m_camera->GetCamera());
+	return m_frameScheduler.IsFrameDue();
+}
+
+inline void Game::Unpause()
+{
+	if (m_sound)
+	{
+		m_sound->Unpause();
+	}
+	m_gameState = GameStateRunning;
+	m_frameScheduler.SetAnimating(true);
+	m_detailController.Reset();
 }
 
 #endif // HOBO_MAIN_GAME_H
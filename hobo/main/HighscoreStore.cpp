@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "main/HighscoreStore.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char s_logMagic[] = "HOBOHS01";
+static const char s_indexMagic[] = "HOBOHI01";
+
+static void PutU32(uint8_t* bytes, uint32_t value)
+{
+	for (size_t i = 0; i < 4; ++i)
+	{
+		bytes[i] = static_cast<uint8_t>(value >> (i * 8));
+	}
+}
+
+static uint32_t GetU32(const uint8_t* bytes)
+{
+	uint32_t value = 0;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		value |= static_cast<uint32_t>(bytes[i]) << (i * 8);
+	}
+	return value;
+}
+
+/**
+ * CRC-32 as used by zip. Records are small, so it goes bit by bit rather
+ * than through a table.
+ */
+static uint32_t Checksum(const uint8_t* bytes, size_t size)
+{
+	uint32_t crc = 0xffffffff;
+	for (size_t i = 0; i < size; ++i)
+	{
+		crc ^= bytes[i];
+		for (size_t bit = 0; bit < 8; ++bit)
+		{
+			crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+		}
+	}
+	return ~crc;
+}
+
+/**
+ * Records are stored little-endian as distance, date, seed and replay id,
+ * followed by a checksum of those 20 bytes.
+ */
+static void EncodeRecord(const HighscoreRecord& record, uint8_t* bytes)
+{
+	uint32_t distanceBits;
+	memcpy(&distanceBits, &record.m_distance, sizeof(distanceBits));
+	const uint64_t date = static_cast<uint64_t>(record.m_date);
+
+	PutU32(bytes, distanceBits);
+	PutU32(bytes + 4, static_cast<uint32_t>(date));
+	PutU32(bytes + 8, static_cast<uint32_t>(date >> 32));
+	PutU32(bytes + 12, record.m_seed);
+	PutU32(bytes + 16, record.m_replayId);
+	PutU32(bytes + 20, Checksum(bytes, 20));
+}
+
+static bool DecodeRecord(const uint8_t* bytes, HighscoreRecord& record)
+{
+	if (GetU32(bytes + 20) != Checksum(bytes, 20))
+	{
+		return false;
+	}
+
+	const uint32_t distanceBits = GetU32(bytes);
+	memcpy(&record.m_distance, &distanceBits, sizeof(distanceBits));
+	record.m_date = static_cast<int64_t>(GetU32(bytes + 4)
+		| static_cast<uint64_t>(GetU32(bytes + 8)) << 32);
+	record.m_seed = GetU32(bytes + 12);
+	record.m_replayId = GetU32(bytes + 16);
+	return true;
+}
+
+static bool WriteAll(int file, const uint8_t* bytes, size_t size)
+{
+	while (size > 0)
+	{
+		const ssize_t written = write(file, bytes, size);
+		if (written < 0 && errno != EINTR)
+		{
+			return false;
+		}
+		else if (written > 0)
+		{
+			bytes += written;
+			size -= written;
+		}
+	}
+	return true;
+}
+
+static bool ReadAll(int file, uint8_t* bytes, size_t size)
+{
+	while (size > 0)
+	{
+		const ssize_t numRead = read(file, bytes, size);
+		if (numRead == 0 || (numRead < 0 && errno != EINTR))
+		{
+			return false;
+		}
+		else if (numRead > 0)
+		{
+			bytes += numRead;
+			size -= numRead;
+		}
+	}
+	return true;
+}
+
+HighscoreStore::HighscoreStore(const std::string& directory)
+	: m_logFilePath(directory + "/highscores.log")
+	, m_indexFilePath(directory + "/highscores.idx")
+	, m_logFile(-1)
+	, m_numWrittenRecords(0)
+#if !defined(SINGLE_THREADED)
+	, m_quit(false)
+#endif // !defined(SINGLE_THREADED)
+{
+	m_top.reserve(s_numTop + 1);
+	m_writtenTop.reserve(s_numTop + 1);
+
+	Open();
+
+#if !defined(SINGLE_THREADED)
+	m_thread = std::thread(&HighscoreStore::ThreadLoop, this);
+#endif // !defined(SINGLE_THREADED)
+}
+
+HighscoreStore::~HighscoreStore()
+{
+#if !defined(SINGLE_THREADED)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_condition.notify_one();
+	m_thread.join();
+#endif // !defined(SINGLE_THREADED)
+
+	if (m_logFile >= 0)
+	{
+		close(m_logFile);
+	}
+}
+
+int HighscoreStore::Record(float distance, uint32_t seed, uint32_t replayId)
+{
+	HighscoreRecord record;
+	record.m_distance = distance;
+	record.m_date = static_cast<int64_t>(time(NULL));
+	record.m_seed = seed;
+	record.m_replayId = replayId;
+
+#if defined(SINGLE_THREADED)
+	const int rank = InsertTop(m_top, record);
+	Append(std::vector<HighscoreRecord>(1, record));
+	return rank;
+#else
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const int rank = InsertTop(m_top, record);
+	m_pending.push_back(record);
+	m_condition.notify_one();
+	return rank;
+#endif // defined(SINGLE_THREADED)
+}
+
+std::vector<HighscoreRecord> HighscoreStore::GetTopScores() const
+{
+#if !defined(SINGLE_THREADED)
+	std::lock_guard<std::mutex> lock(m_mutex);
+#endif // !defined(SINGLE_THREADED)
+	return m_top;
+}
+
+int HighscoreStore::InsertTop(
+	std::vector<HighscoreRecord>& top,
+	const HighscoreRecord& record)
+{
+	size_t rank = top.size();
+	while (rank > 0 && top[rank - 1].m_distance < record.m_distance)
+	{
+		--rank;
+	}
+
+	if (rank >= s_numTop)
+	{
+		return -1;
+	}
+
+	top.insert(top.begin() + rank, record);
+	if (top.size() > s_numTop)
+	{
+		top.pop_back();
+	}
+
+	return static_cast<int>(rank);
+}
+
+void HighscoreStore::Open()
+{
+	m_logFile = open(m_logFilePath.c_str(), O_RDWR | O_CREAT, 0644);
+	if (m_logFile < 0)
+	{
+		printf("Could not open %s.\n", m_logFilePath.c_str());
+		return;
+	}
+
+	struct stat logStat;
+	fstat(m_logFile, &logStat);
+	off_t logSize = logStat.st_size;
+
+	uint8_t header[s_headerSize];
+	if (logSize < static_cast<off_t>(s_headerSize))
+	{
+		memcpy(header, s_logMagic, s_headerSize);
+		if (ftruncate(m_logFile, 0) != 0
+			|| !WriteAll(m_logFile, header, s_headerSize)
+			|| fsync(m_logFile) != 0)
+		{
+			printf("Could not write %s.\n", m_logFilePath.c_str());
+			close(m_logFile);
+			m_logFile = -1;
+			return;
+		}
+		logSize = s_headerSize;
+	}
+	else if (!ReadAll(m_logFile, header, s_headerSize)
+		|| memcmp(header, s_logMagic, s_headerSize) != 0)
+	{
+		// Leave whatever it is alone and only keep scores in memory.
+		printf("%s is not a highscore log.\n", m_logFilePath.c_str());
+		close(m_logFile);
+		m_logFile = -1;
+		return;
+	}
+
+	const uint32_t numLogRecords =
+		static_cast<uint32_t>((logSize - s_headerSize) / s_recordSize);
+
+	// Start over from the beginning of the log if the index is unusable.
+	if (!ReadIndex() || m_numWrittenRecords > numLogRecords)
+	{
+		m_writtenTop.clear();
+		m_numWrittenRecords = 0;
+	}
+
+	// Catch up with the records appended after the index was written.
+	const uint32_t numIndexedRecords = m_numWrittenRecords;
+	lseek(m_logFile, s_headerSize + m_numWrittenRecords * s_recordSize,
+		SEEK_SET);
+
+	uint8_t bytes[s_recordSize];
+	HighscoreRecord record;
+	while (m_numWrittenRecords < numLogRecords
+		&& ReadAll(m_logFile, bytes, s_recordSize)
+		&& DecodeRecord(bytes, record))
+	{
+		InsertTop(m_writtenTop, record);
+		++m_numWrittenRecords;
+	}
+
+	// Cut a record torn by a crash, new records go after the last good one.
+	const off_t logEnd = s_headerSize + m_numWrittenRecords * s_recordSize;
+	if (logEnd != logSize && ftruncate(m_logFile, logEnd) != 0)
+	{
+		printf("Could not truncate %s.\n", m_logFilePath.c_str());
+	}
+	lseek(m_logFile, logEnd, SEEK_SET);
+
+	m_top = m_writtenTop;
+
+	if (m_numWrittenRecords != numIndexedRecords)
+	{
+		WriteIndex(m_writtenTop, m_numWrittenRecords);
+	}
+}
+
+/**
+ * The index holds a magic, the number of log records it covers, the number
+ * of top records and the top records, followed by a checksum of it all.
+ */
+bool HighscoreStore::ReadIndex()
+{
+	FILE* file = fopen(m_indexFilePath.c_str(), "rb");
+	if (!file)
+	{
+		return false;
+	}
+
+	uint8_t bytes[s_headerSize + 8 + s_numTop * s_recordSize + 4];
+	const size_t size = fread(bytes, 1, sizeof(bytes), file);
+	fclose(file);
+
+	if (size < s_headerSize + 12
+		|| memcmp(bytes, s_indexMagic, s_headerSize) != 0)
+	{
+		return false;
+	}
+
+	const uint32_t numTop = GetU32(bytes + s_headerSize + 4);
+	const size_t checksumPos = s_headerSize + 8 + numTop * s_recordSize;
+	if (numTop > s_numTop
+		|| size != checksumPos + 4
+		|| GetU32(bytes + checksumPos) != Checksum(bytes, checksumPos))
+	{
+		return false;
+	}
+
+	m_writtenTop.resize(numTop);
+	for (size_t i = 0; i < numTop; ++i)
+	{
+		const size_t recordPos = s_headerSize + 8 + i * s_recordSize;
+		if (!DecodeRecord(bytes + recordPos, m_writtenTop[i]))
+		{
+			return false;
+		}
+	}
+
+	m_numWrittenRecords = GetU32(bytes + s_headerSize);
+	return true;
+}
+
+void HighscoreStore::WriteIndex(
+	const std::vector<HighscoreRecord>& top,
+	uint32_t numRecords) const
+{
+	const size_t checksumPos = s_headerSize + 8 + top.size() * s_recordSize;
+	std::vector<uint8_t> bytes(checksumPos + 4);
+	memcpy(bytes.data(), s_indexMagic, s_headerSize);
+	PutU32(bytes.data() + s_headerSize, numRecords);
+	PutU32(bytes.data() + s_headerSize + 4, static_cast<uint32_t>(top.size()));
+	for (size_t i = 0; i < top.size(); ++i)
+	{
+		const size_t recordPos = s_headerSize + 8 + i * s_recordSize;
+		EncodeRecord(top[i], bytes.data() + recordPos);
+	}
+	PutU32(bytes.data() + checksumPos, Checksum(bytes.data(), checksumPos));
+
+	// Replace the index atomically, a crash leaves either the old or the new.
+	const std::string tempFilePath = m_indexFilePath + ".tmp";
+	const int file = open(
+		tempFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	const bool written = file >= 0
+		&& WriteAll(file, bytes.data(), bytes.size())
+		&& fsync(file) == 0;
+	if (file >= 0)
+	{
+		close(file);
+	}
+
+	if (!written || rename(tempFilePath.c_str(), m_indexFilePath.c_str()) != 0)
+	{
+		printf("Could not write %s.\n", m_indexFilePath.c_str());
+	}
+}
+
+void HighscoreStore::Append(const std::vector<HighscoreRecord>& records)
+{
+	if (m_logFile < 0)
+	{
+		return;
+	}
+
+	std::vector<uint8_t> bytes(records.size() * s_recordSize);
+	for (size_t i = 0; i < records.size(); ++i)
+	{
+		EncodeRecord(records[i], bytes.data() + i * s_recordSize);
+	}
+
+	if (!WriteAll(m_logFile, bytes.data(), bytes.size())
+		|| fsync(m_logFile) != 0)
+	{
+		printf("Could not write %s.\n", m_logFilePath.c_str());
+
+		// Cut what made it into the log, so that the next records are not
+		// appended after a torn one.
+		const off_t logEnd = s_headerSize + m_numWrittenRecords * s_recordSize;
+		if (ftruncate(m_logFile, logEnd) != 0)
+		{
+			printf("Could not truncate %s.\n", m_logFilePath.c_str());
+		}
+		lseek(m_logFile, logEnd, SEEK_SET);
+		return;
+	}
+
+	for (const auto& record : records)
+	{
+		InsertTop(m_writtenTop, record);
+	}
+	m_numWrittenRecords += static_cast<uint32_t>(records.size());
+
+	// Only written once the records are synced, so it never covers records
+	// that are not in the log.
+	WriteIndex(m_writtenTop, m_numWrittenRecords);
+}
+
+#if !defined(SINGLE_THREADED)
+void HighscoreStore::ThreadLoop()
+{
+	std::vector<HighscoreRecord> records;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_condition.wait(lock, [this]()
+		{
+			return m_quit || !m_pending.empty();
+		});
+
+		// Write whatever is pending before quitting.
+		if (m_pending.empty())
+		{
+			break;
+		}
+
+		records.swap(m_pending);
+		lock.unlock();
+
+		Append(records);
+		records.clear();
+
+		lock.lock();
+	}
+}
+#endif // !defined(SINGLE_THREADED)
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_HIGHSCORESTORE_H
+#define HOBO_MAIN_HIGHSCORESTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if !defined(SINGLE_THREADED)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif // !defined(SINGLE_THREADED)
+
+struct HighscoreRecord
+{
+	float m_distance;
+	int64_t m_date;
+	uint32_t m_seed;
+	uint32_t m_replayId;
+};
+
+/**
+ * Stores every finished run in an append-only log of fixed-size records, and
+ * keeps the best runs in memory. Recording a run only queues it, the log is
+ * written and synced on a background thread.
+ *
+ * The best runs are also saved to a small index together with the number of
+ * log records they cover, so that opening the store only reads the records
+ * appended after the index was written. A record torn by a crash fails its
+ * checksum and is cut from the log when opening it.
+ */
+class HighscoreStore final
+{
+public:
+
+	static const size_t s_numTop = 10;
+
+	HighscoreStore(const std::string& directory);
+	~HighscoreStore();
+
+	/**
+	 * Returns the rank of the run among the best runs, or -1 if it did not
+	 * make it.
+	 */
+	int Record(float distance, uint32_t seed, uint32_t replayId);
+
+	std::vector<HighscoreRecord> GetTopScores() const;
+
+private:
+
+	static const size_t s_recordSize = 24;
+	static const size_t s_headerSize = 8;
+
+	static int InsertTop(
+		std::vector<HighscoreRecord>& top,
+		const HighscoreRecord& record);
+
+	void Open();
+	bool ReadIndex();
+	void WriteIndex(
+		const std::vector<HighscoreRecord>& top,
+		uint32_t numRecords) const;
+	void Append(const std::vector<HighscoreRecord>& records);
+
+#if !defined(SINGLE_THREADED)
+	void ThreadLoop();
+#endif // !defined(SINGLE_THREADED)
+
+	std::string m_logFilePath;
+	std::string m_indexFilePath;
+	int m_logFile;
+
+	// The best runs shown to the player, including runs not yet written.
+	std::vector<HighscoreRecord> m_top;
+
+	// The best runs in the log, and the number of records in it. Only
+	// touched by the writing thread once opened.
+	std::vector<HighscoreRecord> m_writtenTop;
+	uint32_t m_numWrittenRecords;
+
+#if !defined(SINGLE_THREADED)
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::vector<HighscoreRecord> m_pending;
+	bool m_quit;
+	std::thread m_thread;
+#endif // !defined(SINGLE_THREADED)
+};
+
+#endif // HOBO_MAIN_HIGHSCORESTORE_H
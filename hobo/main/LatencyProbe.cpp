@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "main/LatencyProbe.h"
+
+#include <algorithm>
+#include <cstdio>
+
+LatencyProbe::LatencyProbe()
+	: m_numInputs(0)
+	, m_markerFrame(false)
+{
+}
+
+void LatencyProbe::FrameBegin()
+{
+	// Whatever was drawn last frame has now been swapped to the screen.
+	const auto now = Clock::now();
+	while (!m_samples.empty() && m_samples.front().m_drawn)
+	{
+		m_swapHistogram.Add(now - m_samples.front().m_inputTime);
+		m_samples.pop_front();
+	}
+	m_markerFrame = false;
+}
+
+void LatencyProbe::InputReceived()
+{
+	Sample sample;
+	++m_numInputs;
+	sample.m_inputTime = Clock::now();
+	sample.m_updated = false;
+	sample.m_drawn = false;
+	m_samples.push_back(sample);
+}
+
+void LatencyProbe::UpdateFinished()
+{
+	const auto now = Clock::now();
+	for (auto& sample : m_samples)
+	{
+		if (!sample.m_updated)
+		{
+			m_updateHistogram.Add(now - sample.m_inputTime);
+			sample.m_updated = true;
+			m_markerFrame = true;
+		}
+	}
+}
+
+void LatencyProbe::DrawSubmitted()
+{
+	const auto now = Clock::now();
+	for (auto& sample : m_samples)
+	{
+		if (sample.m_updated && !sample.m_drawn)
+		{
+			m_drawHistogram.Add(now - sample.m_inputTime);
+			sample.m_drawn = true;
+		}
+	}
+}
+
+void LatencyProbe::Report() const
+{
+	printf("Touch latency after %u taps:\n", m_numInputs);
+	m_updateHistogram.Report("update");
+	m_drawHistogram.Report("draw");
+	m_swapHistogram.Report("swap");
+}
+
+LatencyProbe::Histogram::Histogram()
+	: m_numSamples(0)
+	, m_total(Clock::duration::zero())
+	, m_max(Clock::duration::zero())
+{
+	m_buckets.fill(0);
+}
+
+void LatencyProbe::Histogram::Add(Clock::duration latency)
+{
+	const auto ms =
+		std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+	const size_t bucket = std::min(
+		static_cast<size_t>(ms / s_bucketWidth), s_numBuckets - 1);
+	++m_buckets[bucket];
+	++m_numSamples;
+	m_total += latency;
+	m_max = std::max(m_max, latency);
+}
+
+void LatencyProbe::Histogram::Report(const char* name) const
+{
+	if (m_numSamples == 0)
+	{
+		return;
+	}
+
+	typedef std::chrono::duration<float, std::milli> FloatMs;
+	printf("  %s: mean %.2f ms, max %.2f ms\n", name,
+		FloatMs(m_total).count() / m_numSamples, FloatMs(m_max).count());
+
+	for (size_t i = 0; i < s_numBuckets; ++i)
+	{
+		if (m_buckets[i] > 0)
+		{
+			const bool last = i == s_numBuckets - 1;
+			printf("    %3zu%s ms: %u\n", i * s_bucketWidth,
+				last ? "+" : " ", m_buckets[i]);
+		}
+	}
+}
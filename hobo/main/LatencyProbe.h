@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_LATENCYPROBE_H
+#define HOBO_MAIN_LATENCYPROBE_H
+
+#include <array>
+#include <chrono>
+#include <deque>
+
+/**
+ * Measures touch-to-photon latency. Each tap is tagged when it reaches the
+ * game and is then followed through the game update, the draw submission and
+ * the buffer swap. The swap is taken to have happened when the next frame
+ * begins, since that is the first point after the swap the game gets to see.
+ */
+class LatencyProbe final
+{
+public:
+
+	LatencyProbe();
+
+	void FrameBegin();
+	void InputReceived();
+	void UpdateFinished();
+	void DrawSubmitted();
+
+	bool IsMarkerFrame() const;
+
+	void Report() const;
+
+private:
+
+	typedef std::chrono::steady_clock Clock;
+
+	class Histogram final
+	{
+	public:
+
+		Histogram();
+
+		void Add(Clock::duration latency);
+		void Report(const char* name) const;
+
+	private:
+
+		static const int s_bucketWidth = 2;
+		static const size_t s_numBuckets = 50;
+
+		std::array<unsigned int, s_numBuckets> m_buckets;
+		unsigned int m_numSamples;
+		Clock::duration m_total;
+		Clock::duration m_max;
+	};
+
+	struct Sample
+	{
+		Clock::time_point m_inputTime;
+		bool m_updated;
+		bool m_drawn;
+	};
+
+	std::deque<Sample> m_samples;
+	unsigned int m_numInputs;
+	bool m_markerFrame;
+
+	Histogram m_updateHistogram;
+	Histogram m_drawHistogram;
+	Histogram m_swapHistogram;
+};
+
+inline bool LatencyProbe::IsMarkerFrame() const
+{
+	return m_markerFrame;
+}
+
+#endif // HOBO_MAIN_LATENCYPROBE_H
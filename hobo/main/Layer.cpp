@@ -35,17 +35,24 @@
 #include "main/EntityTypes.h"
 #include "main/BillboardET.h"
 #include "main/CameraObject.h"
+#include "main/ViewCuller.h"
 
 Layer::Layer(
 	INanaka* nanaka,
 	CameraObject& camera,
+	ViewCuller& viewCuller,
 	std::shared_ptr<World> world,
 	LayerType type)
 	: m_nanaka(nanaka)
 	, m_camera(camera)
+	, m_viewCuller(viewCuller)
 	, m_world(world)
 {
 	m_layerHeight = 0.0f;
+	m_scrollPhase = 0.0f;
+	m_enabled = true;
+	m_startX = 0.0f;
+	m_layoutDirty = true;
 
 	switch (type)
 	{
@@ -107,24 +114,42 @@ void Layer::UpdateViewSize()
 			m_billboardWidth, m_billboardHeight, m_billboardTex);
 		m_billboards.push_back(m_nanaka->GetEntitySystem().SpawnEntity(
 			BillboardEntityType, &billboardParams, &m_world->GetEntityTree()));
+		ShowBillboard(m_billboards.back(), m_enabled);
 	}
 	for (int i = m_billboards.size() - numBillboards; i > 0; --i)
 	{
+		m_viewCuller.Remove(m_billboards[m_billboards.size() - i]);
 		m_billboards[m_billboards.size() - i]->DetachFromParent();
 	}
 	m_billboards.resize(numBillboards);
+	m_layoutDirty = true;
 }
 
 void Layer::SetScroll(float scroll)
 {
+	if (!m_enabled)
+	{
+		return;
+	}
+
 	// Compute position of first billboard in layer, with parallax scroll.
-	const float scaledScroll = scroll * m_scrollMultiplier;
+	const float scaledScroll = scroll * m_scrollMultiplier + m_scrollPhase;
 	const float scaledStartX =
 		static_cast<int>(scaledScroll / m_billboardWidth) * m_billboardWidth
 			- (scaledScroll < 0 ? m_billboardWidth : 0.0f);
 	const float startX = scroll - (scaledScroll - scaledStartX)
 		+ m_billboardWidth * 0.5f;
 
+	// Moving an entity updates its transform right away, so leave the
+	// billboards be when they are already in place, e.g. for the redrawn
+	// frames of a stopped player or a resized view while paused.
+	if (!m_layoutDirty && startX == m_startX)
+	{
+		return;
+	}
+	m_startX = startX;
+	m_layoutDirty = false;
+
 	m_billboards[0]->SetPosition(Vec3f(startX, m_layerDepth, m_layerHeight));
 
 	float lastBillboardX = startX;
@@ -135,3 +160,41 @@ void Layer::SetScroll(float scroll)
 			Vec3f(lastBillboardX, m_layerDepth, m_layerHeight));
 	}
 }
+
+void Layer::ShiftOrigin(float offset)
+{
+	// Only the phase within one billboard matters, keep it small.
+	m_scrollPhase = std::fmod(
+		m_scrollPhase + offset * m_scrollMultiplier, m_billboardWidth);
+}
+
+void Layer::SetEnabled(bool enabled)
+{
+	if (enabled == m_enabled)
+	{
+		return;
+	}
+
+	m_enabled = enabled;
+	m_layoutDirty = true;
+	for (auto& billboard : m_billboards)
+	{
+		ShowBillboard(billboard, m_enabled);
+	}
+}
+
+void Layer::ShowBillboard(std::shared_ptr<Entity> billboard, bool show)
+{
+	// Shown billboards are left to the culler, hidden ones are kept from it.
+	if (show)
+	{
+		m_viewCuller.Add(billboard, BillboardET::s_gfxId,
+			m_billboardWidth, m_billboardHeight);
+	}
+	else
+	{
+		m_viewCuller.Remove(billboard);
+		billboard->GetModule<SceneEM>()->SetVisibility(
+			BillboardET::s_gfxId, false);
+	}
+}
@@ -33,6 +33,7 @@
 class CameraObject;
 class Entity;
 class INanaka;
+class ViewCuller;
 class World;
 
 enum LayerType
@@ -51,14 +52,28 @@ public:
 	Layer(
 		INanaka* nanaka,
 		CameraObject& camera,
+		ViewCuller& viewCuller,
 		std::shared_ptr<World> world,
 		LayerType type);
 
 	void UpdateViewSize();
 	void SetScroll(float scroll);
 
+	/**
+	 * Keeps the parallax pattern in place when the world is moved back along
+	 * x by offset, see Player::ShiftOrigin.
+	 */
+	void ShiftOrigin(float offset);
+
+	/**
+	 * Disabled layers are hidden and not scrolled.
+	 */
+	void SetEnabled(bool enabled);
+
 private:
 
+	void ShowBillboard(std::shared_ptr<Entity> billboard, bool show);
+
 	std::vector<std::shared_ptr<Entity>> m_billboards;
 
 	float m_billboardWidth;
@@ -66,10 +81,15 @@ private:
 	float m_layerDepth;
 	float m_layerHeight;
 	float m_scrollMultiplier;
+	float m_scrollPhase;
+	bool m_enabled;
+	float m_startX;
+	bool m_layoutDirty;
 	std::string m_billboardTex;
 
 	INanaka* m_nanaka;
 	CameraObject& m_camera;
+	ViewCuller& m_viewCuller;
 	std::shared_ptr<World> m_world;
 };
 
@@ -34,9 +34,35 @@
 #include "main/BillboardET.h"
 #include "main/CameraObjectET.h"
 #include "main/EntityTypes.h"
+#include "main/FrameGate.h"
+#include "main/FrameStats.h"
 #include "main/PlayerET.h"
+#include "main/PlayerSpriteET.h"
 #include "main/TriggerET.h"
 
+#if defined(__ANDROID__)
+static const char s_defaultSaveDirectory[] =
+	"/data/data/com.madhobo.hobo/files";
+#else
+static const char s_defaultSaveDirectory[] = ".";
+#endif // defined(__ANDROID__)
+
+static GameHost s_gameHost;
+
+GameHost::GameHost()
+	: m_frameStats(NULL)
+	, m_frameGate(NULL)
+	, m_runSeeds(NULL)
+	, m_saveDirectory(s_defaultSaveDirectory)
+	, m_recordHighscores(true)
+{
+}
+
+void SetGameHost(const GameHost& host)
+{
+	s_gameHost = host;
+}
+
 IGame* CreateGame()
 {
 	return new Main();
@@ -46,61 +72,158 @@ void Main::Initialize(INanaka* nanaka)
 {
 	m_nanaka = nanaka;
 
-	auto gotoGameView = [&]()
-	{
-		m_nanaka->GetGUI().SetActiveView(m_gameViewId);
-		m_currentView = m_gameViewId;
-	};
-
-	auto gotoMenuView = [&]()
-	{
-		m_nanaka->GetGUI().SetActiveView(m_menuViewId);
-		m_currentView = m_menuViewId;
-	};
+	m_frameStats = s_gameHost.m_frameStats;
+	m_frameGate = s_gameHost.m_frameGate;
+	m_runSeeds = s_gameHost.m_runSeeds
+		? s_gameHost.m_runSeeds : &m_randomSeeds;
+	m_highscoreStore = std::unique_ptr<HighscoreStore>(
+		new HighscoreStore(s_gameHost.m_saveDirectory));
 
 	auto fontId = m_nanaka->GetGUI().RegisterFont("Fonts/Default.nft");
-	const Font* font = m_nanaka->GetGUI().GetFont(fontId);
+	m_font = m_nanaka->GetGUI().GetFont(fontId);
 
 	m_menuViewId = m_nanaka->GetGUI().CreateView();
 	auto menuView = std::unique_ptr<MenuView>(
-		new MenuView(gotoGameView, *font));
+		new MenuView([this]() { GotoGameView(); }, *m_font));
 	m_nanaka->GetGUI().SetViewContent(m_menuViewId, menuView->GetViewPanel());
 
-	m_gameViewId = m_nanaka->GetGUI().CreateView();
-	auto gameView = std::unique_ptr<GameView>(
-		new GameView(gotoMenuView, *font));
-	m_nanaka->GetGUI().SetViewContent(m_gameViewId, gameView->GetViewPanel());
-
 	auto& entitySystem = m_nanaka->GetEntitySystem();
 	entitySystem.RegisterEntityType<PlayerET>(PlayerEntityType);
+	entitySystem.RegisterEntityType<PlayerSpriteET>(PlayerSpriteEntityType);
 	entitySystem.RegisterEntityType<TriggerET>(TriggerEntityType);
 	entitySystem.RegisterEntityType<BillboardET>(BillboardEntityType);
 	entitySystem.RegisterEntityType<CameraObjectET>(CameraEntityType);
 
-	m_game = std::unique_ptr<Game>(new Game(m_nanaka, std::move(gameView)));
-	m_menu = std::unique_ptr<Menu>(new Menu(m_nanaka, std::move(menuView)));
+	m_menu = std::unique_ptr<Menu>(
+		new Menu(m_nanaka, std::move(menuView), *m_highscoreStore));
+
+	// The game is built later, see GameLoop.
+	m_buildStage = BuildStageView;
+	m_menuShown = false;
 
-	gotoMenuView();
+	GotoMenuView();
 }
 
 void Main::GameLoop()
 {
-	if (m_currentView == m_gameViewId)
+	if (m_frameGate)
+	{
+		m_frameGate->FrameBegin();
+	}
+
+	if (m_frameStats)
+	{
+		m_frameStats->FrameBegin();
+	}
+
+	// Views keep showing their last frame when there is nothing new to draw.
+	bool drawGame = false;
+	bool drawMenu = false;
+
+	if (m_game && m_currentView == m_gameViewId)
 	{
 		m_game->Update();
-		m_game->Draw();
+		drawGame = m_game->IsFrameDue();
 	}
-	else
+	else if (m_menu->IsFrameDue())
 	{
 		m_menu->Update();
+		drawMenu = true;
+	}
+
+	if (m_frameStats)
+	{
+		m_frameStats->UpdateEnd();
+	}
+
+	if (drawGame)
+	{
+		m_game->Draw();
+	}
+	else if (drawMenu)
+	{
 		m_menu->Draw();
 	}
+
+	if (m_frameStats)
+	{
+		m_frameStats->FrameEnd();
+	}
+
+	if (m_frameGate)
+	{
+		m_frameGate->FrameEnd();
+	}
+
+	// Build the game while the menu is showing rather than before it, once
+	// the first menu frame is out.
+	if (m_buildStage != BuildStageDone && m_menuShown)
+	{
+		BuildNextStage();
+	}
+	m_menuShown = m_menuShown || drawMenu;
 }
 
 void Main::OnPause()
 {
-	if (m_currentView == m_gameViewId)
+	if (m_game && m_currentView == m_gameViewId)
 	{
 		m_game->Pause();
 	}
 }
+
+void Main::BuildNextStage()
+{
+	switch (m_buildStage)
+	{
+	case BuildStageView:
+		m_gameViewId = m_nanaka->GetGUI().CreateView();
+		m_gameView = std::unique_ptr<GameView>(
+			new GameView([this]() { GotoMenuView(); }, *m_font));
+		m_nanaka->GetGUI().SetViewContent(
+			m_gameViewId, m_gameView->GetViewPanel());
+		m_buildStage = BuildStageGame;
+		break;
+
+	case BuildStageGame:
+		m_game = std::unique_ptr<Game>(new Game(
+			m_nanaka,
+			std::move(m_gameView),
+			*m_runSeeds,
+			s_gameHost.m_recordHighscores ? m_highscoreStore.get() : NULL));
+		if (m_frameGate && m_frameGate->IsLockstep())
+		{
+			m_game->SetFixedFrameLength(Game::s_targetFrameLength);
+		}
+		m_buildStage = BuildStageSound;
+		break;
+
+	case BuildStageSound:
+		m_game->LoadSound();
+		m_buildStage = BuildStageDone;
+		break;
+
+	case BuildStageDone:
+		break;
+	}
+}
+
+void Main::GotoGameView()
+{
+	// Play may be pushed before the game has been built in the background.
+	while (m_buildStage != BuildStageDone)
+	{
+		BuildNextStage();
+	}
+
+	m_nanaka->GetGUI().SetActiveView(m_gameViewId);
+	m_currentView = m_gameViewId;
+	m_game->Invalidate();
+}
+
+void Main::GotoMenuView()
+{
+	m_nanaka->GetGUI().SetActiveView(m_menuViewId);
+	m_currentView = m_menuViewId;
+	m_menu->Invalidate();
+}
@@ -27,11 +27,60 @@
 #define HOBO_MAIN_MAIN_H
 
 #include <memory>
+#include <string>
 
 #include "nanaka/main/IGame.h"
 
 #include "main/Game.h"
+#include "main/HighscoreStore.h"
 #include "main/Menu.h"
+#include "main/RunSeeds.h"
+
+class Font;
+class FrameGate;
+class FrameStats;
+
+/**
+ * What a platform hands to the game. The engine creates the game through
+ * CreateGame, which takes no arguments, so a platform with anything to hand
+ * over sets it with SetGameHost before starting the engine thread. Main reads
+ * it once in Initialize and passes each part on to what uses it.
+ */
+struct GameHost
+{
+	GameHost();
+
+	/**
+	 * Collects frame times for a frame time benchmark, or NULL.
+	 */
+	FrameStats* m_frameStats;
+
+	/**
+	 * Counts the frames, or runs them in lockstep with the platform, or NULL.
+	 * In lockstep the game advances a fixed frame length every frame.
+	 */
+	FrameGate* m_frameGate;
+
+	/**
+	 * Seeds the runs of a recorded or replayed session, or NULL to seed them
+	 * at random.
+	 */
+	RunSeeds* m_runSeeds;
+
+	/**
+	 * Where the highscores are kept, defaults to where the platform lets the
+	 * game store files.
+	 */
+	std::string m_saveDirectory;
+
+	/**
+	 * Whether finished runs are recorded as highscores, replayed runs are not
+	 * new runs.
+	 */
+	bool m_recordHighscores;
+};
+
+void SetGameHost(const GameHost& host);
 
 class Main final : public IGame
 {
@@ -48,14 +97,43 @@ public:
 
 private:
 
+	/**
+	 * The game is built a stage per frame while the menu is showing, so that
+	 * the menu keeps responding.
+	 */
+	enum BuildStage
+	{
+		BuildStageView,
+		BuildStageGame,
+		BuildStageSound,
+		BuildStageDone,
+	};
+
+	void BuildNextStage();
+	void GotoGameView();
+	void GotoMenuView();
+
 	INanaka* m_nanaka;
+	const Font* m_font;
+
+	FrameStats* m_frameStats;
+	FrameGate* m_frameGate;
+	RunSeeds* m_runSeeds;
+	RunSeeds m_randomSeeds;
+
+	std::unique_ptr<HighscoreStore> m_highscoreStore;
 
 	std::unique_ptr<Menu> m_menu;
 	std::unique_ptr<Game> m_game;
 
+	BuildStage m_buildStage;
+	std::unique_ptr<GameView> m_gameView;
+
 	UUID m_menuViewId;
 	UUID m_gameViewId;
 	UUID m_currentView;
+
+	bool m_menuShown;
 };
 
 #endif // HOBO_MAIN_MAIN_H
@@ -32,9 +32,18 @@
 
 #include "main/BillboardET.h"
 #include "main/EntityTypes.h"
+#include "main/HighscoreStore.h"
 
-Menu::Menu(INanaka* nanaka, std::unique_ptr<MenuView> menuView)
+// The sun ray is the only thing moving, it turns slowly enough for 30 fps.
+const float Menu::s_minFrameLength = 1000.0f / 30.0f;
+
+Menu::Menu(
+	INanaka* nanaka,
+	std::unique_ptr<MenuView> menuView,
+	const HighscoreStore& highscoreStore)
 	: m_nanaka(nanaka)
+	, m_highscoreStore(highscoreStore)
+	, m_frameScheduler(s_minFrameLength)
 	, m_menuView(std::move(menuView))
 {
 	m_menuView->SetClient(this);
@@ -60,6 +69,7 @@ Menu::Menu(INanaka* nanaka, std::unique_ptr<MenuView> menuView)
 	m_ray->SetPosition(Vec3f(-1.0f, 0.0f, -1.0f));
 
 	m_renderTarget = m_menuView->GetRenderPanel();
+	m_renderTarget->SetRenderTargetPanelListener(this);
 	m_camera.SetRenderContextId(m_renderTarget->GetRenderContextId());
 
 	m_rotationAnimation.AddKeyframe(
@@ -90,3 +100,15 @@ void Menu::Shutdown()
 {
 	m_nanaka->Shutdown();
 }
+
+void Menu::OpenHighscoreBoard()
+{
+	std::vector<float> distances;
+	for (const auto& record : m_highscoreStore.GetTopScores())
+	{
+		distances.push_back(record.m_distance);
+	}
+
+	m_menuView->ShowHighscoreBoard(distances);
+	Invalidate();
+}
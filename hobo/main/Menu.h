@@ -30,31 +30,53 @@
 
 #include "nanaka/main/World.h"
 #include "nanaka/graphics/KeyframedAnimation.h"
+#include "nanaka/gui/RenderTargetPanel.h"
 #include "nanaka/scene/Camera.h"
 
 #include "gui/MenuView.h"
+#include "main/FrameScheduler.h"
 
 class Entity;
+class HighscoreStore;
 class INanaka;
-class RenderTargetPanel;
 
-class Menu final : public World, public MenuViewClient
+class Menu final
+	: public World
+	, public RenderTargetPanelListener
+	, public MenuViewClient
 {
 public:
 
-	Menu(INanaka* nanaka, std::unique_ptr<MenuView> menuView);
+	Menu(
+		INanaka* nanaka,
+		std::unique_ptr<MenuView> menuView,
+		const HighscoreStore& highscoreStore);
+
+	void Invalidate();
+	bool IsFrameDue();
 
 	void Update();
 	void Draw() const;
 
+	/**
+	 * RenderTargetPanelListener implementation.
+	 */
+	void OnNewSize(UUID panelId);
+
 	/**
 	 * MenuViewClient implementation.
 	 */
 	void Shutdown() override;
+	void OpenHighscoreBoard() override;
 
 private:
 
+	static const float s_minFrameLength;
+
 	INanaka* m_nanaka;
+	const HighscoreStore& m_highscoreStore;
+
+	FrameScheduler m_frameScheduler;
 
 	Camera m_camera;
 	KeyframedAnimation<float> m_rotationAnimation;
@@ -64,4 +86,19 @@ private:
 	std::unique_ptr<MenuView> m_menuView;
 };
 
+inline void Menu::Invalidate()
+{
+	m_frameScheduler.Invalidate();
+}
+
+inline bool Menu::IsFrameDue()
+{
+	return m_frameScheduler.IsFrameDue();
+}
+
+inline void Menu::OnNewSize(UUID panelId)
+{
+	Invalidate();
+}
+
 #endif // HOBO_GUI_MENU_H
@@ -30,24 +30,32 @@
 
 #include "nanaka/game/GameEM.h"
 #include "nanaka/math/Quat.h"
-#include "nanaka/physics/PhysicsEM.h"
 #include "nanaka/utils/Time.h"
 
 #include "main/ComboController.h"
-#include "main/PlayerET.h"
+#include "main/PlayerSpriteET.h"
+#include "main/RenderSnapshot.h"
+#include "main/SimulationState.h"
+#include "main/StateHash.h"
 #include "main/TimeController.h"
+#include "main/Tunables.h"
 
 const float Player::s_ascentScoreFull = 5.0f;
 const float Player::s_groundOffset = 0.75f;
-const float Player::s_soarDistanceFull = 500.0f;
-const float Player::s_groundHitVelScale = 0.8f;
-const float Player::s_bounceBoost = 2.0f;
+const float Player::s_originShift = 1024.0f;
 const long unsigned int Player::s_hitAnimDuration = 500;
 
-Player::Player(ComboController& comboController, TimeController& timeController)
+Player::Player(
+	ComboController& comboController,
+	TimeController& timeController,
+	const Tunables& tunables)
 	: m_comboController(comboController)
 	, m_timeController(timeController)
+	, m_tunables(tunables)
 	, m_vel(0.0f)
+	, m_velocity(Vec3f::Zero())
+	, m_spriteEM(NULL)
+	, m_gfxId(PlayerSpriteET::s_gfxIdNone)
 {
 	m_rotationAnimation.AddKeyframe(
 		1000, 0.0f, Interpolation<float>::Linear());
@@ -62,10 +70,9 @@ void Player::Reset(float x)
 	GetEntity()->SetRotation(Quat::NoRot());
 	GetEntity()->SetPosition(Vec3f(x, 0.0f, s_groundOffset));
 
-	auto physicsEM = GetEntity()->GetModule<PhysicsEM>();
-	physicsEM->SetVelocity(Vec3f::Zero());
+	m_velocity = Vec3f::Zero();
 
-	ShowGfxId(PlayerET::s_gfxIdIdle);
+	ShowGfxId(PlayerSpriteET::s_gfxIdIdle);
 
 	ResetPlayer();
 }
@@ -75,6 +82,7 @@ void Player::ResetPlayer()
 	m_rotationAnimation.ResetAnimation();
 
 	m_distance = 0.0f;
+	m_originX = 0.0;
 
 	m_vel *= 0.0f;
 
@@ -96,26 +104,34 @@ void Player::Update(Time& time)
 {
 	if (!m_stopped)
 	{
-		if (m_hitAnim && m_timeHit + s_hitAnimDuration < time.GetGameTime())
+		const float gameStep = m_timeController.GetGameStep();
+
+		if (m_hitAnim
+			&& m_timeHit + s_hitAnimDuration < m_timeController.TimeNow())
 		{
-			ShowGfxId(PlayerET::s_gfxIdFlying);
+			ShowGfxId(PlayerSpriteET::s_gfxIdFlying);
 			m_hitAnim = false;
 		}
 
-		Vec3f position = GetEntity()->GetPosition();
+		// The velocity is kept here rather than in the physics module, which
+		// would move the player by the engine time.
+		Vec3f position =
+			GetEntity()->GetPosition() + m_velocity * gameStep * 0.001f;
+		GetEntity()->SetPosition(position);
 
 		bool groundHit = position.z < s_groundOffset;
 		if (groundHit)
 		{
-			position.z = -(position.z - s_groundOffset) * s_groundHitVelScale
-				+ s_groundOffset;
+			position.z = -(position.z - s_groundOffset)
+				* m_tunables.m_groundHitVelScale + s_groundOffset;
 			GetEntity()->SetPosition(position);
 
 			if (!m_triggerCollision)
 			{
 				if (m_bounce)
 				{
-					AddVelocity(atanf(m_vel.y / m_vel.x), s_bounceBoost);
+					AddVelocity(
+						atanf(m_vel.y / m_vel.x), m_tunables.m_bounceBoost);
 					if (!m_comboController.IsComboActivated())
 					{
 						m_timeController.EnterSlowmotion();
@@ -123,7 +139,7 @@ void Player::Update(Time& time)
 				}
 				else
 				{
-					ScaleVelocity(s_groundHitVelScale);
+					ScaleVelocity(m_tunables.m_groundHitVelScale);
 				}
 
 				m_comboController.GroundHit();
@@ -145,22 +161,20 @@ void Player::Update(Time& time)
 		if (m_gravity)
 		{
 			const Vec3f gravity = Vec3f(0.0f, 0.0f, -9.82f);
-			auto physicsEM = GetEntity()->GetModule<PhysicsEM>();
-			auto vel = physicsEM->GetVelocity();
-			vel += gravity * time.GetGameStep() * 0.001f;
-			physicsEM->SetVelocity(vel);
+			m_velocity += gravity * gameStep * 0.001f;
 		}
 
 		if (!m_soaring)
 		{
 			m_rotationAnimation.Animate(
-				time.GetGameStep() * m_vel.Length() / 15.0f);
+				gameStep * m_vel.Length() / 15.0f);
 			GetEntity()->SetRotation(
 				Quat(Vec3f::UnitY(), m_rotationAnimation.GetValue()));
 		}
 
 		m_soarGuageLoad = std::min(1.0f,
-			m_soarGuageLoad + (position.x - m_distance) / s_soarDistanceFull);
+			m_soarGuageLoad
+			+ (position.x - m_distance) / m_tunables.m_soarDistanceFull);
 
 		m_distance = position.x;
 
@@ -171,6 +185,89 @@ void Player::Update(Time& time)
 	}
 }
 
+void Player::FillRenderSnapshot(RenderSnapshot& snapshot) const
+{
+	snapshot.m_playerPosition = GetEntity()->GetPosition();
+	snapshot.m_playerAngle = m_rotationAnimation.GetValue();
+	snapshot.m_speed = m_vel.x;
+	snapshot.m_distance = static_cast<float>(GetDistance());
+	snapshot.m_soarLoad = m_soarGuageLoad;
+	snapshot.m_ascentLoad = m_ascentGuageLoad;
+	snapshot.m_height = snapshot.m_playerPosition.z;
+}
+
+void Player::HashState(StateHash& hash) const
+{
+	hash.Add(GetEntity()->GetPosition());
+	hash.Add(m_velocity);
+	hash.Add(m_distance);
+	hash.Add(m_originX);
+	hash.Add(m_vel.x);
+	hash.Add(m_vel.y);
+	hash.Add(m_stopped);
+	hash.Add(m_soaring);
+	hash.Add(m_gravity);
+	hash.Add(m_bounce);
+	hash.Add(m_pass);
+	hash.Add(m_soarGuageLoad);
+	hash.Add(m_ascentGuageLoad);
+	hash.Add(m_triggerCollision);
+	hash.Add(m_hitAnim);
+	hash.Add(m_timeHit);
+}
+
+void Player::SaveState(SimulationState& state) const
+{
+	state.m_playerPosition = GetEntity()->GetPosition();
+	state.m_playerRotation = GetEntity()->GetRotation();
+	state.m_playerVelocity = m_velocity;
+	state.m_playerRotationAnimation = m_rotationAnimation;
+	state.m_playerDistance = m_distance;
+	state.m_playerOriginX = m_originX;
+	state.m_playerVel = m_vel;
+	state.m_playerStopped = m_stopped;
+	state.m_playerSoaring = m_soaring;
+	state.m_playerGravity = m_gravity;
+	state.m_playerBounce = m_bounce;
+	state.m_playerPass = m_pass;
+	state.m_playerSoarGuageLoad = m_soarGuageLoad;
+	state.m_playerAscentGuageLoad = m_ascentGuageLoad;
+	state.m_playerTriggerCollision = m_triggerCollision;
+	state.m_playerHitAnim = m_hitAnim;
+	state.m_playerTimeHit = m_timeHit;
+}
+
+void Player::RestoreState(const SimulationState& state)
+{
+	GetEntity()->SetPosition(state.m_playerPosition);
+	GetEntity()->SetRotation(state.m_playerRotation);
+	m_velocity = state.m_playerVelocity;
+	m_rotationAnimation = state.m_playerRotationAnimation;
+	m_distance = state.m_playerDistance;
+	m_originX = state.m_playerOriginX;
+	m_vel = state.m_playerVel;
+	m_stopped = state.m_playerStopped;
+	m_soaring = state.m_playerSoaring;
+	m_gravity = state.m_playerGravity;
+	m_bounce = state.m_playerBounce;
+	m_pass = state.m_playerPass;
+	m_soarGuageLoad = state.m_playerSoarGuageLoad;
+	m_ascentGuageLoad = state.m_playerAscentGuageLoad;
+	m_triggerCollision = state.m_playerTriggerCollision;
+	m_hitAnim = state.m_playerHitAnim;
+	m_timeHit = state.m_playerTimeHit;
+}
+
+void Player::ShiftOrigin(float offset)
+{
+	Vec3f position = GetEntity()->GetPosition();
+	position.x -= offset;
+	GetEntity()->SetPosition(position);
+
+	m_distance -= offset;
+	m_originX += offset;
+}
+
 void Player::KickOff(float angle, float vel)
 {
 	m_stopped = false;
@@ -185,20 +282,22 @@ bool Player::AddComboScore(float score)
 	return m_ascentGuageLoad == 1.0f;
 }
 
-void Player::Soar()
+bool Player::CanSoar() const
 {
-	Vec3f position = GetEntity()->GetPosition();
-
-	auto physicsEM = GetEntity()->GetModule<PhysicsEM>();
-	Vec3f vel = physicsEM->GetVelocity();
+	const Vec3f position = GetEntity()->GetPosition();
 
 	// Soar if full gauge, not stopped, falling, and between 2-15m above ground.
-	if (m_soarGuageLoad == 1.0f && !m_stopped && vel.z < 0.0f
-			&& position.z > 2.0f && position.z < 15.0f)
+	return m_soarGuageLoad == 1.0f && !m_stopped && m_velocity.z < 0.0f
+		&& position.z > 2.0f && position.z < 15.0f;
+}
+
+void Player::Soar()
+{
+	if (CanSoar())
 	{
 		const float soarAngle = (10.0f / 180.0f) * 3.142f;
-		physicsEM->SetVelocity(
-			Vec3f(cos(soarAngle), 0.0f, -sin(soarAngle)) * vel.Length());
+		m_velocity = Vec3f(cos(soarAngle), 0.0f, -sin(soarAngle))
+			* m_velocity.Length();
 
 		m_soarGuageLoad = 0.0f;
 		m_soaring = true;
@@ -211,21 +310,19 @@ void Player::Soar()
 void Player::SkewTrajectory()
 {
 	std::swap(m_vel.x, m_vel.y);
-	auto physicsEM = GetEntity()->GetModule<PhysicsEM>();
-	physicsEM->SetVelocity(Vec3f(m_vel.x, 0.0f, m_vel.y));
+	m_velocity = Vec3f(m_vel.x, 0.0f, m_vel.y);
 }
 
 void Player::StopByTrigger()
 {
 	Stop();
-	ShowGfxId(PlayerET::s_gfxIdNone);
+	ShowGfxId(PlayerSpriteET::s_gfxIdNone);
 }
 
 void Player::HeadStraight(float angle, float vel)
 {
 	m_gravity = false;
-	auto physicsEM = GetEntity()->GetModule<PhysicsEM>();
-	physicsEM->SetVelocity(Vec3f(cos(angle), 0.0f, sin(angle)) * vel);
+	m_velocity = Vec3f(cos(angle), 0.0f, sin(angle)) * vel;
 }
 
 void Player::SetPass(PlayerPass pass)
@@ -243,15 +340,13 @@ void Player::Stop()
 void Player::ScaleVelocity(float velScaleFactor)
 {
 	m_vel *= velScaleFactor;
-	auto physicsEM = GetEntity()->GetModule<PhysicsEM>();
-	physicsEM->SetVelocity(Vec3f(m_vel.x, 0.0f, m_vel.y));
+	m_velocity = Vec3f(m_vel.x, 0.0f, m_vel.y);
 }
 
 void Player::AddVelocity(float angle, float vel)
 {
 	m_vel += Vec2f(cos(angle), sin(angle)) * vel;
-	auto physicsEM = GetEntity()->GetModule<PhysicsEM>();
-	physicsEM->SetVelocity(Vec3f(m_vel.x, 0.0f, m_vel.y));
+	m_velocity = Vec3f(m_vel.x, 0.0f, m_vel.y);
 }
 
 void Player::TriggerCollision()
@@ -264,23 +359,36 @@ void Player::WasHit()
 {
 	if (!m_stopped)
 	{
-		ShowGfxId(PlayerET::s_gfxIdHit);
+		ShowGfxId(PlayerSpriteET::s_gfxIdHit);
 		m_hitAnim = true;
 		m_timeHit = m_timeController.TimeNow();
 	}
 }
 
+void Player::SetSprite(SceneEM* spriteEM)
+{
+	m_spriteEM = spriteEM;
+	ShowGfxId(m_gfxId);
+}
+
 void Player::ShowGfxId(AttachmentId gfxId)
 {
-	auto sceneEM = GetEntity()->GetModule<SceneEM>();
-	sceneEM->SetVisibility(
-		PlayerET::s_gfxIdIdle, gfxId == PlayerET::s_gfxIdIdle);
-	sceneEM->SetVisibility(
-		PlayerET::s_gfxIdFlying, gfxId == PlayerET::s_gfxIdFlying);
-	sceneEM->SetVisibility(
-		PlayerET::s_gfxIdHit, gfxId == PlayerET::s_gfxIdHit);
-	if (gfxId != PlayerET::s_gfxIdNone)
+	m_gfxId = gfxId;
+
+	// Headless simulations have nothing to show.
+	if (!m_spriteEM)
+	{
+		return;
+	}
+
+	m_spriteEM->SetVisibility(PlayerSpriteET::s_gfxIdIdle,
+		gfxId == PlayerSpriteET::s_gfxIdIdle);
+	m_spriteEM->SetVisibility(PlayerSpriteET::s_gfxIdFlying,
+		gfxId == PlayerSpriteET::s_gfxIdFlying);
+	m_spriteEM->SetVisibility(PlayerSpriteET::s_gfxIdHit,
+		gfxId == PlayerSpriteET::s_gfxIdHit);
+	if (gfxId != PlayerSpriteET::s_gfxIdNone)
 	{
-		sceneEM->ResetAnimation(gfxId);
+		m_spriteEM->ResetAnimation(gfxId);
 	}
 }
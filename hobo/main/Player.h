@@ -32,10 +32,12 @@
 #include "nanaka/math/Vec2f.h"
 #include "nanaka/scene/SceneEM.h"
 
-#include "gui/PlayerHUD.h"
-
 class ComboController;
 class TimeController;
+class StateHash;
+struct RenderSnapshot;
+struct SimulationState;
+struct Tunables;
 
 enum PlayerPass
 {
@@ -48,10 +50,25 @@ class Player final : public GameObject
 {
 public:
 
-	Player(ComboController& comboController, TimeController& timeController);
+	Player(
+		ComboController& comboController,
+		TimeController& timeController,
+		const Tunables& tunables);
+
+	/**
+	 * The player is moved back this far whenever it passes this far from the
+	 * world origin, see ShiftOrigin.
+	 */
+	static const float s_originShift;
 
 	void Reset(float x);
 
+	/**
+	 * The scene module of the entity showing the player, see PlayerSpriteET.
+	 * Without one the player is not shown.
+	 */
+	void SetSprite(SceneEM* spriteEM);
+
 	void KickOff(float angle, float vel);
 	bool AddComboScore(float score);
 	void Soar();
@@ -69,21 +86,36 @@ public:
 	PlayerPass GetPass() const;
 	bool HasPass() const;
 	bool IsStopped() const;
+	bool CanSoar() const;
+
+	/**
+	 * Distance travelled since the start, unaffected by origin shifts.
+	 */
+	double GetDistance() const;
+	bool IsPastOriginShift() const;
+
+	/**
+	 * Moves the player back along x by offset, keeping the total distance.
+	 * Everything else in the world has to be moved back along with it.
+	 */
+	void ShiftOrigin(float offset);
+
+	void FillRenderSnapshot(RenderSnapshot& snapshot) const;
+	void HashState(StateHash& hash) const;
 
-	void UpdatePlayerHUD(PlayerHUD& playerHUD) const;
+	void SaveState(SimulationState& state) const;
+	void RestoreState(const SimulationState& state);
 
 	/**
-	 * GameObject implementation.
+	 * GameObject implementation. The player moves by the clock of the time
+	 * controller rather than the engine time, see TimeController.
 	 */
 	void Update(Time& time) override;
 
 private:
 
 	static const float s_groundOffset;
-	static const float s_soarDistanceFull;
 	static const float s_ascentScoreFull;
-	static const float s_groundHitVelScale;
-	static const float s_bounceBoost;
 	static const long unsigned int s_hitAnimDuration;
 
 	void ResetPlayer();
@@ -94,12 +126,15 @@ private:
 
 	ComboController& m_comboController;
 	TimeController& m_timeController;
+	const Tunables& m_tunables;
 
 	KeyframedAnimation<float> m_rotationAnimation;
 
 	float m_distance;
+	double m_originX;
 
 	Vec2f m_vel;
+	Vec3f m_velocity;
 
 	bool m_stopped;
 	bool m_soaring;
@@ -112,7 +147,10 @@ private:
 
 	bool m_triggerCollision;
 	bool m_hitAnim;
-	long unsigned int m_timeHit;
+	double m_timeHit;
+
+	SceneEM* m_spriteEM;
+	AttachmentId m_gfxId;
 };
 
 inline void Player::ResumeGravity()
@@ -125,6 +163,16 @@ inline void Player::SetBounce(bool bounce)
 	m_bounce = bounce;
 }
 
+inline double Player::GetDistance() const
+{
+	return m_originX + m_distance;
+}
+
+inline bool Player::IsPastOriginShift() const
+{
+	return m_distance > s_originShift;
+}
+
 inline PlayerPass Player::GetPass() const
 {
 	return m_pass;
@@ -145,10 +193,4 @@ inline void Player::StopSoar()
 	m_soaring = false;
 }
 
-inline void Player::UpdatePlayerHUD(PlayerHUD& playerHUD) const
-{
-	playerHUD.Update(m_vel.x, m_distance, m_soarGuageLoad, m_ascentGuageLoad,
-		GetEntity()->GetPosition().z);
-}
-
 #endif // HOBO_MAIN_PLAYER_H
@@ -34,17 +34,18 @@
 
 PlayerEMParams::PlayerEMParams(
 	ComboController& comboController,
-	TimeController& timeController)
+	TimeController& timeController,
+	const Tunables& tunables)
 	: m_comboController(comboController)
 	, m_timeController(timeController)
+	, m_tunables(tunables)
 {
 }
 
 PlayerET::PlayerET()
 	: EntityType({
 		GameEntityModuleType,
-		PhysicsEntityModuleType,
-		SceneEntityModuleType})
+		PhysicsEntityModuleType})
 {
 }
 
@@ -54,32 +55,17 @@ void PlayerET::InitializeEntity(
 {
 	auto gameEM = entity.GetModule<GameEM>();
 	auto physicsEM = entity.GetModule<PhysicsEM>();
-	auto sceneEM = entity.GetModule<SceneEM>();
 
 	const auto params = static_cast<const PlayerEMParams*>(spawnParams);
 	auto& comboController = params->m_comboController;
 	auto& timeController = params->m_timeController;
+	auto& tunables = params->m_tunables;
 
 	gameEM->SetGameObject(std::unique_ptr<GameObject>(
-		new Player(comboController, timeController)));
+		new Player(comboController, timeController, tunables)));
 
 	auto collisionBox = std::unique_ptr<CollisionBox>(new CollisionBox());
 	collisionBox->SetPosition(Vec3f(0.0f, 100.0f, 0.0f));
 	collisionBox->SetDimensions(Vec3f(0.375f, 100.0f, 0.375f));
 	physicsEM->AddCollisionShape(std::move(collisionBox));
-
-	auto idleAnimatedBillboard = AnimatedBillboard("Player/Idle.banim");
-	idleAnimatedBillboard.SetScale(Vec3f(1.5f, 1.0f, 1.5f));
-	sceneEM->SetAttachment<AnimatedBillboard>(
-		s_gfxIdIdle, idleAnimatedBillboard);
-
-	auto soaringAnimatedBillboard = AnimatedBillboard("Player/Flying.banim");
-	soaringAnimatedBillboard.SetScale(Vec3f(1.5f, 1.0f ,1.5f));
-	sceneEM->SetAttachment<AnimatedBillboard>(
-		s_gfxIdFlying, soaringAnimatedBillboard);
-
-	auto hitAnimatedBillboard = AnimatedBillboard("Player/Hit.banim");
-	hitAnimatedBillboard.SetScale(Vec3f(1.5f, 1.0f, 1.5f));
-	sceneEM->SetAttachment<AnimatedBillboard>(
-		s_gfxIdHit, hitAnimatedBillboard);
 }
@@ -27,10 +27,10 @@
 #define HOBO_MAIN_PLAYERET_H
 
 #include "nanaka/entity/EntityType.h"
-#include "nanaka/scene/SceneEM.h"
 
 class ComboController;
 class TimeController;
+struct Tunables;
 
 class PlayerEMParams final : public EntityModuleParameters
 {
@@ -38,10 +38,12 @@ public:
 
 	PlayerEMParams(
 		ComboController& comboController,
-		TimeController& timeController);
+		TimeController& timeController,
+		const Tunables& tunables);
 
 	ComboController& m_comboController;
 	TimeController& m_timeController;
+	const Tunables& m_tunables;
 };
 
 class PlayerET final : public EntityType
@@ -50,11 +52,6 @@ public:
 
 	PlayerET();
 
-	static const AttachmentId s_gfxIdNone = 0;
-	static const AttachmentId s_gfxIdIdle = 1;
-	static const AttachmentId s_gfxIdFlying = 2;
-	static const AttachmentId s_gfxIdHit = 3;
-
 	/**
 	 * EntityType implementation.
 	 */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "main/PlayerSpriteET.h"
+
+#include "nanaka/entity/Entity.h"
+
+PlayerSpriteET::PlayerSpriteET()
+	: EntityType({SceneEntityModuleType})
+{
+}
+
+void PlayerSpriteET::InitializeEntity(
+	Entity& entity,
+	const EntityModuleParameters* spawnParams) const
+{
+	auto sceneEM = entity.GetModule<SceneEM>();
+
+	auto idleAnimatedBillboard = AnimatedBillboard("Player/Idle.banim");
+	idleAnimatedBillboard.SetScale(Vec3f(1.5f, 1.0f, 1.5f));
+	sceneEM->SetAttachment<AnimatedBillboard>(
+		s_gfxIdIdle, idleAnimatedBillboard);
+
+	auto soaringAnimatedBillboard = AnimatedBillboard("Player/Flying.banim");
+	soaringAnimatedBillboard.SetScale(Vec3f(1.5f, 1.0f ,1.5f));
+	sceneEM->SetAttachment<AnimatedBillboard>(
+		s_gfxIdFlying, soaringAnimatedBillboard);
+
+	auto hitAnimatedBillboard = AnimatedBillboard("Player/Hit.banim");
+	hitAnimatedBillboard.SetScale(Vec3f(1.5f, 1.0f, 1.5f));
+	sceneEM->SetAttachment<AnimatedBillboard>(
+		s_gfxIdHit, hitAnimatedBillboard);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_RENDERSNAPSHOT_H
+#define HOBO_MAIN_RENDERSNAPSHOT_H
+
+#include <array>
+
+#include "nanaka/math/Vec2f.h"
+#include "nanaka/math/Vec3f.h"
+
+#include "gui/TriggerHUD.h"
+#include "main/ComboController.h"
+
+/**
+ * The presentation state after one simulation step. At the end of each
+ * update, Game sets the HUD from the latest snapshot and interpolates the
+ * view between the last two, all on the game thread. Drawing only reads.
+ */
+struct RenderSnapshot final
+{
+	RenderSnapshot();
+
+	Vec3f m_cameraPosition;
+	Vec2f m_cameraViewDimensions;
+	Vec3f m_playerPosition;
+	// The player only spins about the y axis, by this angle.
+	float m_playerAngle;
+	float m_layerScroll;
+
+	float m_speed;
+	float m_distance;
+	float m_soarLoad;
+	float m_ascentLoad;
+	float m_height;
+
+	std::array<bool, ComboTypeNum> m_availableCombos;
+	bool m_playerHasPass;
+	bool m_comboActive;
+	float m_comboTimeLeft;
+
+	std::array<TriggerHUDIndicator, 3> m_triggerIndicators;
+};
+
+inline RenderSnapshot::RenderSnapshot()
+	: m_cameraPosition(Vec3f::Zero())
+	, m_cameraViewDimensions(Vec2f::Zero())
+	, m_playerPosition(Vec3f::Zero())
+	, m_playerAngle(0.0f)
+	, m_layerScroll(0.0f)
+	, m_speed(0.0f)
+	, m_distance(0.0f)
+	, m_soarLoad(0.0f)
+	, m_ascentLoad(0.0f)
+	, m_height(0.0f)
+	, m_playerHasPass(false)
+	, m_comboActive(false)
+	, m_comboTimeLeft(0.0f)
+{
+	m_availableCombos.fill(false);
+	m_triggerIndicators.fill(NoneTriggerHUDIndicator);
+}
+
+#endif // HOBO_MAIN_RENDERSNAPSHOT_H
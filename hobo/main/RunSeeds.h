@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_RUNSEEDS_H
+#define HOBO_MAIN_RUNSEEDS_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Hands out the seed of each run. Seeds given to Replay are handed out first,
+ * after that they are random. Every seed handed out is kept, so that a
+ * recorded session can be replayed with the same runs.
+ */
+class RunSeeds final
+{
+public:
+
+	RunSeeds();
+
+	void Replay(const std::vector<unsigned int>& seeds);
+
+	unsigned int Next();
+
+	const std::vector<unsigned int>& GetSeeds() const;
+
+private:
+
+	std::vector<unsigned int> m_seeds;
+	size_t m_nextSeed;
+};
+
+inline const std::vector<unsigned int>& RunSeeds::GetSeeds() const
+{
+	return m_seeds;
+}
+
+#endif // HOBO_MAIN_RUNSEEDS_H
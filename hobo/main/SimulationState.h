@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_SIMULATIONSTATE_H
+#define HOBO_MAIN_SIMULATIONSTATE_H
+
+#include <array>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "nanaka/graphics/KeyframedAnimation.h"
+#include "nanaka/math/Quat.h"
+#include "nanaka/math/Vec2f.h"
+#include "nanaka/math/Vec3f.h"
+
+#include "main/ComboController.h"
+#include "main/Player.h"
+#include "main/Trigger.h"
+
+struct TriggerState final
+{
+	TriggerType m_type;
+	TriggerAction m_action;
+	bool m_collisionRegistered;
+	bool m_hasNextTrigger;
+	TriggerType m_nextTriggerType;
+	Vec3f m_position;
+};
+
+/**
+ * The gameplay state of one game, enough to restore it into the same or
+ * another set of game objects and continue simulating from there. Triggers
+ * are referred to by type since there is exactly one trigger of each type.
+ *
+ * The clock of the time controller is part of the state, so time stamps such
+ * as when the player was hit stay meaningful in another set of game objects.
+ * The simulation does not depend on the engine Time.
+ */
+struct SimulationState final
+{
+	// Player
+	Vec3f m_playerPosition;
+	Quat m_playerRotation;
+	Vec3f m_playerVelocity;
+	KeyframedAnimation<float> m_playerRotationAnimation;
+	float m_playerDistance;
+	double m_playerOriginX;
+	Vec2f m_playerVel;
+	bool m_playerStopped;
+	bool m_playerSoaring;
+	bool m_playerGravity;
+	bool m_playerBounce;
+	PlayerPass m_playerPass;
+	float m_playerSoarGuageLoad;
+	float m_playerAscentGuageLoad;
+	bool m_playerTriggerCollision;
+	bool m_playerHitAnim;
+	double m_playerTimeHit;
+
+	// ComboController
+	std::array<bool, ComboTypeNum> m_availableCombos;
+	std::list<TriggerType> m_visibleTriggers;
+	bool m_lastHitGround;
+	bool m_lastTriggerHitBoost30;
+	bool m_lastTriggerHitBoost;
+	bool m_playerHasPass;
+	float m_executionTimer;
+	bool m_comboActive;
+	ComboType m_activeComboType;
+	TriggerType m_activeTriggerType;
+
+	// TriggerManager
+	float m_reloadX;
+	float m_startX;
+	std::vector<TriggerState> m_activeTriggers;
+	std::vector<TriggerState> m_availableTriggers;
+	std::mt19937 m_random;
+
+	// TimeController
+	double m_realTime;
+	double m_gameTime;
+	float m_gameStep;
+	float m_gameTimeMultiplier;
+	bool m_slowMotion;
+	double m_timeEnterSlowmotion;
+};
+
+#endif // HOBO_MAIN_SIMULATIONSTATE_H
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_STATEHASH_H
+#define HOBO_MAIN_STATEHASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nanaka/math/Vec3f.h"
+
+/**
+ * 64-bit FNV-1a hash over the game state, used to verify that two runs
+ * simulated exactly the same thing. Floats are hashed by their bit pattern,
+ * so any difference in rounding shows up.
+ */
+class StateHash final
+{
+public:
+
+	StateHash();
+
+	void Add(const void* data, size_t size);
+
+	void Add(bool value);
+	void Add(int value);
+	void Add(long unsigned int value);
+	void Add(float value);
+	void Add(double value);
+	void Add(const Vec3f& value);
+
+	uint64_t GetValue() const;
+
+private:
+
+	uint64_t m_value;
+};
+
+inline void StateHash::Add(bool value)
+{
+	const uint8_t byte = value ? 1 : 0;
+	Add(&byte, sizeof(byte));
+}
+
+inline void StateHash::Add(int value)
+{
+	Add(&value, sizeof(value));
+}
+
+inline void StateHash::Add(long unsigned int value)
+{
+	Add(&value, sizeof(value));
+}
+
+inline void StateHash::Add(float value)
+{
+	Add(&value, sizeof(value));
+}
+
+inline void StateHash::Add(double value)
+{
+	Add(&value, sizeof(value));
+}
+
+inline void StateHash::Add(const Vec3f& value)
+{
+	Add(value.x);
+	Add(value.y);
+	Add(value.z);
+}
+
+inline uint64_t StateHash::GetValue() const
+{
+	return m_value;
+}
+
+#endif // HOBO_MAIN_STATEHASH_H
@@ -25,21 +25,69 @@
 
 #include "main/TimeController.h"
 
+#include "main/SimulationState.h"
+#include "main/StateHash.h"
+
+const float TimeController::s_stepLength = 1000.0f / 60.0f;
 const float TimeController::s_slowMotionDuration = 700;
 
-void TimeController::EnterSlowmotion()
+void TimeController::Reset()
 {
-	m_time.SetGameTimeMultiplier(0.1f);
-	m_timeEnterSlowmotion = m_time.GetRealTime();
-	m_slowMotion = true;
+	m_realTime = 0.0;
+	m_gameTime = 0.0;
+	m_gameStep = 0.0f;
+	m_gameTimeMultiplier = 1.0f;
+	m_slowMotion = false;
+	m_timeEnterSlowmotion = 0.0;
 }
 
-void TimeController::Update()
+void TimeController::Step()
 {
+	m_gameStep = s_stepLength * m_gameTimeMultiplier;
+	m_realTime += s_stepLength;
+	m_gameTime += m_gameStep;
+
 	if (m_slowMotion
-		&& m_timeEnterSlowmotion + s_slowMotionDuration < m_time.GetRealTime())
+		&& m_timeEnterSlowmotion + s_slowMotionDuration < m_realTime)
 	{
-		m_time.SetGameTimeMultiplier(1.0f);
+		m_gameTimeMultiplier = 1.0f;
 		m_slowMotion = false;
 	}
 }
+
+void TimeController::EnterSlowmotion()
+{
+	m_gameTimeMultiplier = 0.1f;
+	m_timeEnterSlowmotion = m_realTime;
+	m_slowMotion = true;
+}
+
+void TimeController::HashState(StateHash& hash) const
+{
+	hash.Add(m_realTime);
+	hash.Add(m_gameTime);
+	hash.Add(m_gameStep);
+	hash.Add(m_gameTimeMultiplier);
+	hash.Add(m_slowMotion);
+	hash.Add(m_timeEnterSlowmotion);
+}
+
+void TimeController::SaveState(SimulationState& state) const
+{
+	state.m_realTime = m_realTime;
+	state.m_gameTime = m_gameTime;
+	state.m_gameStep = m_gameStep;
+	state.m_gameTimeMultiplier = m_gameTimeMultiplier;
+	state.m_slowMotion = m_slowMotion;
+	state.m_timeEnterSlowmotion = m_timeEnterSlowmotion;
+}
+
+void TimeController::RestoreState(const SimulationState& state)
+{
+	m_realTime = state.m_realTime;
+	m_gameTime = state.m_gameTime;
+	m_gameStep = state.m_gameStep;
+	m_gameTimeMultiplier = state.m_gameTimeMultiplier;
+	m_slowMotion = state.m_slowMotion;
+	m_timeEnterSlowmotion = state.m_timeEnterSlowmotion;
+}
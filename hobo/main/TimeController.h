@@ -26,42 +26,82 @@
 #ifndef HOBO_MAIN_TIMECONTROLLER_H
 #define HOBO_MAIN_TIMECONTROLLER_H
 
-#include "nanaka/utils/Time.h"
+class StateHash;
+struct SimulationState;
 
+/**
+ * The clock of the simulation. It only moves when stepped, a fixed length of
+ * real time per step, so that the simulation does not depend on how long the
+ * steps take to compute. Game time runs at a multiple of real time, slower
+ * in slow motion and not at all while frozen.
+ */
 class TimeController final
 {
 public:
 
-	TimeController(Time& time);
+	/**
+	 * Real time of one simulation step, in milliseconds.
+	 */
+	static const float s_stepLength;
+
+	TimeController();
+
+	void Reset();
+	void Step();
 
 	void Freeze();
 	void EnterSlowmotion();
-	void Update();
-	long unsigned int TimeNow();
+
+	double TimeNow() const;
+	float GetGameStep() const;
+	float GetRealStep() const;
+	float GetGameTimeMultiplier() const;
+
+	void HashState(StateHash& hash) const;
+
+	void SaveState(SimulationState& state) const;
+	void RestoreState(const SimulationState& state);
 
 private:
 
 	static const float s_slowMotionDuration;
 
-	Time& m_time;
+	double m_realTime;
+	double m_gameTime;
+	float m_gameStep;
+	float m_gameTimeMultiplier;
 	bool m_slowMotion;
-	int m_timeEnterSlowmotion;
+	double m_timeEnterSlowmotion;
 };
 
-inline TimeController::TimeController(Time& time)
-	: m_time(time)
-	, m_slowMotion(false)
+inline TimeController::TimeController()
 {
+	Reset();
 }
 
 inline void TimeController::Freeze()
 {
-	m_time.SetGameTimeMultiplier(0.0f);
+	m_gameTimeMultiplier = 0.0f;
+}
+
+inline double TimeController::TimeNow() const
+{
+	return m_gameTime;
+}
+
+inline float TimeController::GetGameStep() const
+{
+	return m_gameStep;
+}
+
+inline float TimeController::GetRealStep() const
+{
+	return s_stepLength;
 }
 
-inline long unsigned int TimeController::TimeNow()
+inline float TimeController::GetGameTimeMultiplier() const
 {
-	return m_time.GetGameTime();
+	return m_gameTimeMultiplier;
 }
 
 #endif // HOBO_MAIN_TIMECONTROLLER_H
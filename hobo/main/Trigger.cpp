@@ -32,35 +32,55 @@
 
 #include "main/ComboController.h"
 #include "main/Player.h"
+#include "main/SimulationState.h"
+#include "main/StateHash.h"
 #include "main/TimeController.h"
 #include "main/TriggerET.h"
-
-const float Trigger::s_playerSlowdownVelScale = 0.55f;
+#include "main/Tunables.h"
 
 Trigger::Trigger(
+	SceneEM& sceneEM,
 	TriggerType type,
 	Player& player,
 	ComboController& comboController,
-	TimeController& timeController)
+	TimeController& timeController,
+	const Tunables& tunables,
+	bool playSounds)
 	: m_type(type)
+	, m_nextTrigger(NULL)
+	, m_sceneEM(sceneEM)
 	, m_timeController(timeController)
 	, m_comboController(comboController)
 	, m_player(player)
-	, m_sound("Sounds/trigger.ogg")
+	, m_tunables(tunables)
+	, m_collisionRegistered(false)
 {
+	if (playSounds)
+	{
+		m_sound = std::unique_ptr<Sound>(new Sound("Sounds/trigger.ogg"));
+	}
+
+	SetDefaultAction();
 }
 
 void Trigger::Initialize()
 {
 	m_collisionRegistered = false;
 
-	auto sceneEM = GetEntity()->GetModule<SceneEM>();
-	sceneEM->SetVisibility(TriggerET::s_gfxIdActive, true);
-	sceneEM->SetVisibility(TriggerET::s_gfxIdInactive, false);
+	m_sceneEM.SetVisibility(TriggerET::s_gfxIdActive, true);
+	m_sceneEM.SetVisibility(TriggerET::s_gfxIdInactive, false);
 
 	SetDefaultAction();
 }
 
+void Trigger::Park()
+{
+	GetEntity()->SetPosition(Vec3f(0.0f, 1.0f, -500.0f));
+
+	m_sceneEM.SetVisibility(TriggerET::s_gfxIdActive, false);
+	m_sceneEM.SetVisibility(TriggerET::s_gfxIdInactive, false);
+}
+
 void Trigger::OnCollision(const Collision& collision)
 {
 	if (!m_collisionRegistered)
@@ -93,7 +113,10 @@ void Trigger::OnCollision(const Collision& collision)
 
 		m_player.TriggerCollision();
 
-		m_sound.PlayOnce();
+		if (m_sound)
+		{
+			m_sound->PlayOnce();
+		}
 	}
 	m_collisionRegistered = true;
 }
@@ -146,20 +169,23 @@ void Trigger::PerformAction()
 	switch (m_action)
 	{
 	case TriggerActionBoost30:
-		m_player.AddVelocity(30.0f * 3.14f / 180.0f, 11.0f);
+		m_player.AddVelocity(
+			m_tunables.m_boost30Angle * 3.14f / 180.0f, m_tunables.m_boostVel);
 		break;
 
 	case TriggerActionBoost45:
-		m_player.AddVelocity(45.0f * 3.14f / 180.0f, 11.0f);
+		m_player.AddVelocity(
+			m_tunables.m_boost45Angle * 3.14f / 180.0f, m_tunables.m_boostVel);
 		break;
 
 	case TriggerActionBoost60:
-		m_player.AddVelocity(60.0f * 3.14f / 180.0f, 11.0f);
+		m_player.AddVelocity(
+			m_tunables.m_boost60Angle * 3.14f / 180.0f, m_tunables.m_boostVel);
 		break;
 
 	case TriggerActionSlow:
 		m_player.SetBounce(false);
-		m_player.ScaleVelocity(s_playerSlowdownVelScale);
+		m_player.ScaleVelocity(m_tunables.m_playerSlowdownVelScale);
 		break;
 
 	case TriggerActionAngle:
@@ -180,55 +206,58 @@ void Trigger::PerformAction()
 		break;
 
 	case TriggerActionBoost30Combo:
-		m_player.AddVelocity(30.0f * 3.14f / 180.0f, 16.0f);
+		m_player.AddVelocity(m_tunables.m_boost30Angle * 3.14f / 180.0f,
+			m_tunables.m_comboBoostVel);
 		break;
 
 	case TriggerActionStopCombo:
-		m_player.AddVelocity(45.0f * 3.14f / 180.0f, 22.0f);
+		m_player.AddVelocity(m_tunables.m_stopComboAngle * 3.14f / 180.0f,
+			m_tunables.m_stopComboVel);
 		break;
 
 	case TriggerActionBoost45Combo:
 		m_nextTrigger->SetAction(TriggerActionBoost45ComboFollowup);
-		m_player.HeadStraight(0.0f, 15.0f);
+		m_player.HeadStraight(0.0f, m_tunables.m_comboHeadStraightVel);
 		break;
 
 	case TriggerActionBoost60Combo:
 		m_nextTrigger->SetAction(TriggerActionBoost60ComboFollowup);
-		m_player.HeadStraight(0.0f, 15.0f);
+		m_player.HeadStraight(0.0f, m_tunables.m_comboHeadStraightVel);
 		break;
 
 	case TriggerActionBlock45Combo:
 		m_nextTrigger->SetAction(TriggerActionBlock45ComboFollowup);
 		m_player.SetPass(PlayerPassNone);
-		m_player.HeadStraight(0.0f, 15.0f);
+		m_player.HeadStraight(0.0f, m_tunables.m_comboHeadStraightVel);
 		break;
 
 	case TriggerActionBlock60Combo:
 		m_nextTrigger->SetAction(TriggerActionBlock60ComboFollowup);
 		m_player.SetPass(PlayerPassNone);
-		m_player.HeadStraight(0.0f, 15.0f);
+		m_player.HeadStraight(0.0f, m_tunables.m_comboHeadStraightVel);
 		break;
 
 	case TriggerActionBlock45ComboFollowup:
 		m_player.SetBounce(true);
 	case TriggerActionBoost45ComboFollowup:
-		m_player.AddVelocity(45.0f * 3.14f / 180.0f, 16.0f);
+		m_player.AddVelocity(m_tunables.m_boost45Angle * 3.14f / 180.0f,
+			m_tunables.m_comboBoostVel);
 		m_player.ResumeGravity();
 		break;
 
 	case TriggerActionBlock60ComboFollowup:
 		m_player.SetPass(PlayerPassSuper);
 	case TriggerActionBoost60ComboFollowup:
-		m_player.AddVelocity(60.0f * 3.14f / 180.0f, 16.0f);
+		m_player.AddVelocity(m_tunables.m_boost60Angle * 3.14f / 180.0f,
+			m_tunables.m_comboBoostVel);
 		m_player.ResumeGravity();
 		break;
 	}
 
 	if (m_action != TriggerActionUseBlock && m_action != TriggerActionStopCombo)
 	{
-		auto sceneEM = GetEntity()->GetModule<SceneEM>();
-		sceneEM->SetVisibility(TriggerET::s_gfxIdActive, false);
-		sceneEM->SetVisibility(TriggerET::s_gfxIdInactive, true);
+		m_sceneEM.SetVisibility(TriggerET::s_gfxIdActive, false);
+		m_sceneEM.SetVisibility(TriggerET::s_gfxIdInactive, true);
 	}
 
 	if (m_action != TriggerActionUseBlock && m_action != TriggerActionStop)
@@ -238,3 +267,33 @@ void Trigger::PerformAction()
 
 	m_timeController.EnterSlowmotion();
 }
+
+void Trigger::HashState(StateHash& hash) const
+{
+	hash.Add(m_type);
+	hash.Add(m_action);
+	hash.Add(m_collisionRegistered);
+	hash.Add(GetEntity()->GetPosition());
+}
+
+void Trigger::SaveState(TriggerState& state) const
+{
+	state.m_type = m_type;
+	state.m_action = m_action;
+	state.m_collisionRegistered = m_collisionRegistered;
+	state.m_hasNextTrigger = m_nextTrigger != NULL;
+	state.m_nextTriggerType =
+		m_nextTrigger != NULL ? m_nextTrigger->GetType() : m_type;
+	state.m_position = GetEntity()->GetPosition();
+}
+
+void Trigger::RestoreState(const TriggerState& state, Trigger* nextTrigger)
+{
+	m_action = state.m_action;
+	m_collisionRegistered = state.m_collisionRegistered;
+	m_nextTrigger = nextTrigger;
+	GetEntity()->SetPosition(state.m_position);
+
+	m_sceneEM.SetVisibility(TriggerET::s_gfxIdActive, !m_collisionRegistered);
+	m_sceneEM.SetVisibility(TriggerET::s_gfxIdInactive, m_collisionRegistered);
+}
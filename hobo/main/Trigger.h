@@ -68,19 +68,37 @@ enum TriggerAction
 class TimeController;
 class ComboController;
 class Player;
+class SceneEM;
+class StateHash;
+struct TriggerState;
+struct Tunables;
 
 class Trigger final : public GameObject, public CollisionListener
 {
 public:
 
+	/**
+	 * The scene module is that of the trigger entity, it lives as long as it.
+	 * Headless simulations, which may run on other threads than the game,
+	 * pass playSounds false to keep clear of the sound system.
+	 */
 	Trigger(
+		SceneEM& sceneEM,
 		TriggerType type,
 		Player& player,
 		ComboController& comboController,
-		TimeController& timeController);
+		TimeController& timeController,
+		const Tunables& tunables,
+		bool playSounds);
 
 	void Initialize();
 
+	/**
+	 * Hides the trigger out of reach while it waits in the pool, until the
+	 * next Initialize.
+	 */
+	void Park();
+
 	void SetDefaultAction();
 	void SetAction(TriggerAction action);
 	void PerformAction();
@@ -89,6 +107,11 @@ public:
 
 	TriggerType GetType() const;
 
+	void HashState(StateHash& hash) const;
+
+	void SaveState(TriggerState& state) const;
+	void RestoreState(const TriggerState& state, Trigger* nextTrigger);
+
 	/**
 	 * Collision implementation.
 	 */
@@ -96,19 +119,20 @@ public:
 
 private:
 
-	static const float s_playerSlowdownVelScale;
-
 	TriggerType m_type;
 	TriggerAction m_action;
 	Trigger* m_nextTrigger;
 
+	SceneEM& m_sceneEM;
+
 	TimeController& m_timeController;
 	ComboController& m_comboController;
 	Player& m_player;
+	const Tunables& m_tunables;
 
 	bool m_collisionRegistered;
 
-	Sound m_sound;
+	std::unique_ptr<Sound> m_sound;
 };
 
 inline TriggerType Trigger::GetType() const
@@ -36,11 +36,15 @@ TriggerEMParams::TriggerEMParams(
 	TriggerType triggerType,
 	Player& player,
 	ComboController& comboController,
-	TimeController& timeController)
+	TimeController& timeController,
+	const Tunables& tunables,
+	bool playSounds)
 	: m_triggerType(triggerType)
 	, m_timeController(timeController)
 	, m_comboController(comboController)
 	, m_player(player)
+	, m_tunables(tunables)
+	, m_playSounds(playSounds)
 {
 }
 
@@ -64,10 +68,12 @@ void TriggerET::InitializeEntity(
 	auto& timeController = params->m_timeController;
 	auto& comboController = params->m_comboController;
 	auto& player = params->m_player;
+	auto& tunables = params->m_tunables;
 	auto triggerType = params->m_triggerType;
+	auto playSounds = params->m_playSounds;
 
-	auto trigger = std::unique_ptr<Trigger>(
-		new Trigger(triggerType, player, comboController, timeController));
+	auto trigger = std::unique_ptr<Trigger>(new Trigger(*sceneEM, triggerType,
+		player, comboController, timeController, tunables, playSounds));
 
 	auto collisionBox = std::unique_ptr<CollisionBox>(new CollisionBox());
 	switch (triggerType)
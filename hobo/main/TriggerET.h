@@ -34,6 +34,7 @@
 class TimeController;
 class ComboController;
 class Player;
+struct Tunables;
 
 class TriggerEMParams final : public EntityModuleParameters
 {
@@ -43,12 +44,16 @@ public:
 		TriggerType triggerType,
 		Player& player,
 		ComboController& comboController,
-		TimeController& timeController);
+		TimeController& timeController,
+		const Tunables& tunables,
+		bool playSounds);
 
 	TriggerType m_triggerType;
 	TimeController& m_timeController;
 	ComboController& m_comboController;
 	Player& m_player;
+	const Tunables& m_tunables;
+	bool m_playSounds;
 };
 
 class TriggerET final : public EntityType
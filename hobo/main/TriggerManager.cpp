@@ -31,20 +31,26 @@
 #include "nanaka/main/World.h"
 
 #include "main/EntityTypes.h"
+#include "main/RenderSnapshot.h"
+#include "main/SimulationState.h"
+#include "main/StateHash.h"
 #include "main/Trigger.h"
 #include "main/TriggerET.h"
+#include "main/Tunables.h"
 #include "main/ComboController.h"
 
-const float TriggerManager::s_triggerDistance = 10.0f;
-
 TriggerManager::TriggerManager(
 	INanaka* nanaka,
 	Player& player,
 	TimeController& timeController,
 	ComboController& comboController,
-	std::shared_ptr<World> world)
+	const Tunables& tunables,
+	std::shared_ptr<World> world,
+	bool playSounds)
 	: m_comboController(comboController)
+	, m_tunables(tunables)
 	, m_world(world)
+	, m_random(std::random_device()())
 {
 	std::vector<TriggerType> triggerTypes = {
 		TriggerTypeBoost30,
@@ -59,8 +65,8 @@ TriggerManager::TriggerManager(
 	// Spawn one trigger of each type.
 	for (auto triggerType : triggerTypes)
 	{
-		TriggerEMParams triggerParams(
-			triggerType, player, comboController, timeController);
+		TriggerEMParams triggerParams(triggerType, player, comboController,
+			timeController, tunables, playSounds);
 		auto trigger = nanaka->GetEntitySystem().SpawnEntity(
 			TriggerEntityType, &triggerParams, &m_world->GetEntityTree());
 		m_availableTriggers.push_back(
@@ -70,27 +76,32 @@ TriggerManager::TriggerManager(
 
 void TriggerManager::Update(float x, bool allowBlock)
 {
+	const float triggerDistance = m_tunables.m_triggerDistance;
+
 	while (m_reloadX < x)
 	{
 		// Return the left-most trigger.
 		auto trigger = *m_activeTriggers.begin();
 		m_activeTriggers.erase(m_activeTriggers.begin());
+		trigger->Park();
 
 		// Introduce a new trigger.
-		IntroduceTrigger(m_reloadX + s_triggerDistance * 2.8f, allowBlock);
+		IntroduceTrigger(m_reloadX + triggerDistance * 2.8f, allowBlock);
 
 		m_availableTriggers.push_back(trigger);
 
 		// Move the reload position forward.
-		m_reloadX += s_triggerDistance;
+		m_reloadX += triggerDistance;
 	}
 }
 
 void TriggerManager::Reset(float x)
 {
+	const float triggerDistance = m_tunables.m_triggerDistance;
+
 	// Find good position for first trigger if the player starts at x.
-	m_startX = s_triggerDistance + s_triggerDistance * static_cast<int>(
-		(x + s_triggerDistance - 0.001f) / s_triggerDistance);
+	m_startX = triggerDistance + triggerDistance * static_cast<int>(
+		(x + triggerDistance - 0.001f) / triggerDistance);
 
 	// Return all active triggers to the available array.
 	for (auto trigger : m_activeTriggers)
@@ -102,26 +113,43 @@ void TriggerManager::Reset(float x)
 	// Put all triggers in unreachable positions.
 	for (auto trigger : m_availableTriggers)
 	{
-		trigger->GetEntity()->SetPosition(Vec3f(0.0f, 1.0f, -500.0f));
+		trigger->Park();
 	}
 
 	// Set reload position right after the first trigger.
-	m_reloadX = m_startX + s_triggerDistance * 0.2f;
+	m_reloadX = m_startX + triggerDistance * 0.2f;
 }
 
 void TriggerManager::KickOff()
 {
 	// Introduce three new triggers.
+	const float triggerDistance = m_tunables.m_triggerDistance;
+
 	IntroduceTrigger(m_startX, true);
-	IntroduceTrigger(m_startX + s_triggerDistance, true);
-	IntroduceTrigger(m_startX + s_triggerDistance * 2, true);
+	IntroduceTrigger(m_startX + triggerDistance, true);
+	IntroduceTrigger(m_startX + triggerDistance * 2, true);
+}
+
+void TriggerManager::ShiftOrigin(float offset)
+{
+	// Available triggers are parked out of reach, they are placed anew when
+	// introduced.
+	for (auto trigger : m_activeTriggers)
+	{
+		Vec3f position = trigger->GetEntity()->GetPosition();
+		position.x -= offset;
+		trigger->GetEntity()->SetPosition(position);
+	}
+
+	m_reloadX -= offset;
+	m_startX -= offset;
 }
 
 void TriggerManager::IntroduceTrigger(float x, bool allowBlock)
 {
 	// Take a random available trigger.
 	auto triggerIt = m_availableTriggers.begin()
-		+ m_random.Int(m_availableTriggers.size());
+		+ RandomIndex(m_availableTriggers.size());
 	auto newTrigger = *triggerIt;
 	m_availableTriggers.erase(triggerIt);
 
@@ -129,7 +157,7 @@ void TriggerManager::IntroduceTrigger(float x, bool allowBlock)
 	if (!allowBlock && newTrigger->GetType() == TriggerTypeBlock)
 	{
 		triggerIt = m_availableTriggers.begin()
-			+ m_random.Int(m_availableTriggers.size());
+			+ RandomIndex(m_availableTriggers.size());
 		auto newNewTrigger = *triggerIt;
 		m_availableTriggers.erase(triggerIt);
 		m_availableTriggers.push_back(newTrigger);
@@ -150,12 +178,116 @@ void TriggerManager::IntroduceTrigger(float x, bool allowBlock)
 	m_comboController.TriggerAppeared(newTrigger->GetType());
 }
 
-void TriggerManager::UpdateTriggerHUD(TriggerHUD& triggerHUD) const
+size_t TriggerManager::RandomIndex(size_t size)
+{
+	// Plain modulo rather than a distribution, the mt19937 sequence is fully
+	// specified while the distributions differ between standard libraries.
+	return m_random() % size;
+}
+
+void TriggerManager::Seed(unsigned int seed)
 {
-	triggerHUD.SetIndicators(
-		TriggerHUDIndicatorAt(0),
-		TriggerHUDIndicatorAt(1),
-		TriggerHUDIndicatorAt(2));
+	m_random.seed(seed);
+}
+
+void TriggerManager::HashState(StateHash& hash) const
+{
+	hash.Add(m_reloadX);
+	hash.Add(m_startX);
+
+	for (auto trigger : m_activeTriggers)
+	{
+		trigger->HashState(hash);
+	}
+
+	// The order of the available triggers decides what the next random
+	// index picks.
+	for (auto trigger : m_availableTriggers)
+	{
+		hash.Add(trigger->GetType());
+	}
+}
+
+void TriggerManager::SaveState(SimulationState& state) const
+{
+	state.m_reloadX = m_reloadX;
+	state.m_startX = m_startX;
+	state.m_random = m_random;
+
+	state.m_activeTriggers.resize(m_activeTriggers.size());
+	for (size_t i = 0; i < m_activeTriggers.size(); ++i)
+	{
+		m_activeTriggers[i]->SaveState(state.m_activeTriggers[i]);
+	}
+
+	state.m_availableTriggers.resize(m_availableTriggers.size());
+	for (size_t i = 0; i < m_availableTriggers.size(); ++i)
+	{
+		m_availableTriggers[i]->SaveState(state.m_availableTriggers[i]);
+	}
+}
+
+void TriggerManager::RestoreState(const SimulationState& state)
+{
+	// Look up the triggers before the lists are rebuilt.
+	auto restoreTriggers = [this](
+		const std::vector<TriggerState>& triggerStates,
+		std::vector<Trigger*>& triggers)
+	{
+		for (const auto& triggerState : triggerStates)
+		{
+			auto trigger = GetTrigger(triggerState.m_type);
+			auto nextTrigger = triggerState.m_hasNextTrigger
+				? GetTrigger(triggerState.m_nextTriggerType) : NULL;
+			trigger->RestoreState(triggerState, nextTrigger);
+			triggers.push_back(trigger);
+		}
+	};
+
+	std::vector<Trigger*> activeTriggers;
+	std::vector<Trigger*> availableTriggers;
+	restoreTriggers(state.m_activeTriggers, activeTriggers);
+	restoreTriggers(state.m_availableTriggers, availableTriggers);
+	m_activeTriggers.swap(activeTriggers);
+	m_availableTriggers.swap(availableTriggers);
+
+	for (auto trigger : m_availableTriggers)
+	{
+		trigger->Park();
+	}
+
+	m_reloadX = state.m_reloadX;
+	m_startX = state.m_startX;
+	m_random = state.m_random;
+}
+
+Trigger* TriggerManager::GetTrigger(TriggerType type) const
+{
+	for (auto trigger : m_activeTriggers)
+	{
+		if (trigger->GetType() == type)
+		{
+			return trigger;
+		}
+	}
+
+	for (auto trigger : m_availableTriggers)
+	{
+		if (trigger->GetType() == type)
+		{
+			return trigger;
+		}
+	}
+
+	return NULL;
+}
+
+void TriggerManager::FillRenderSnapshot(RenderSnapshot& snapshot) const
+{
+	for (size_t i = 0; i < snapshot.m_triggerIndicators.size(); ++i)
+	{
+		snapshot.m_triggerIndicators[i] = TriggerHUDIndicatorAt(i);
+	}
 }
 
 TriggerHUDIndicator TriggerManager::TriggerHUDIndicatorAt(size_t idx) const
@@ -27,40 +27,59 @@
 #define HOBO_MAIN_TRIGGERMANAGER_H
 
 #include <memory>
+#include <random>
 #include <vector>
 
-#include "nanaka/utils/Random.h"
-
 #include "gui/TriggerHUD.h"
+#include "main/Trigger.h"
 
 class ComboController;
 class INanaka;
 class Player;
+class StateHash;
+struct SimulationState;
 class TimeController;
-class Trigger;
+struct Tunables;
 class World;
+struct RenderSnapshot;
 
 class TriggerManager final
 {
 public:
 
+	/**
+	 * See Trigger for playSounds.
+	 */
 	TriggerManager(
 		INanaka* nanaka,
 		Player& player,
 		TimeController& timeController,
 		ComboController& comboController,
-		std::shared_ptr<World> world);
+		const Tunables& tunables,
+		std::shared_ptr<World> world,
+		bool playSounds);
 
 	void Update(float x, bool allowBlock);
-	void UpdateTriggerHUD(TriggerHUD& triggerHUD) const;
+	void FillRenderSnapshot(RenderSnapshot& snapshot) const;
+	void HashState(StateHash& hash) const;
+
+	void Seed(unsigned int seed);
+
+	void SaveState(SimulationState& state) const;
+	void RestoreState(const SimulationState& state);
+	Trigger* GetTrigger(TriggerType type) const;
 	void Reset(float x);
 	void KickOff();
 
-private:
+	/**
+	 * Moves the triggers back along x by offset, see Player::ShiftOrigin.
+	 */
+	void ShiftOrigin(float offset);
 
-	static const float s_triggerDistance;
+private:
 
 	void IntroduceTrigger(float x, bool allowBlock);
+	size_t RandomIndex(size_t size);
 	TriggerHUDIndicator TriggerHUDIndicatorAt(size_t idx) const;
 
 	float m_reloadX;
@@ -70,9 +89,10 @@ private:
 	std::vector<Trigger*> m_activeTriggers;
 
 	ComboController& m_comboController;
+	const Tunables& m_tunables;
 	std::shared_ptr<World> m_world;
 
-	Random m_random;
+	std::mt19937 m_random;
 };
 
 #endif // HOBO_MAIN_TRIGGERMANAGER_H
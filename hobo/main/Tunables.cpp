@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "main/Tunables.h"
+
+#include <utility>
+
+typedef std::pair<std::string, float Tunables::*> TunableEntry;
+
+static const std::vector<TunableEntry>& GetEntries()
+{
+	static const std::vector<TunableEntry> entries = {
+		{ "boost30Angle", &Tunables::m_boost30Angle },
+		{ "boost45Angle", &Tunables::m_boost45Angle },
+		{ "boost60Angle", &Tunables::m_boost60Angle },
+		{ "boostVel", &Tunables::m_boostVel },
+		{ "comboBoostVel", &Tunables::m_comboBoostVel },
+		{ "comboHeadStraightVel", &Tunables::m_comboHeadStraightVel },
+		{ "stopComboAngle", &Tunables::m_stopComboAngle },
+		{ "stopComboVel", &Tunables::m_stopComboVel },
+		{ "playerSlowdownVelScale", &Tunables::m_playerSlowdownVelScale },
+		{ "groundHitVelScale", &Tunables::m_groundHitVelScale },
+		{ "bounceBoost", &Tunables::m_bounceBoost },
+		{ "soarDistanceFull", &Tunables::m_soarDistanceFull },
+		{ "comboTimeToExecute", &Tunables::m_comboTimeToExecute },
+		{ "triggerDistance", &Tunables::m_triggerDistance },
+	};
+	return entries;
+}
+
+float* Tunables::Find(const std::string& name)
+{
+	for (const auto& entry : GetEntries())
+	{
+		if (entry.first == name)
+		{
+			return &(this->*entry.second);
+		}
+	}
+
+	return NULL;
+}
+
+static std::vector<std::string> MakeNames()
+{
+	std::vector<std::string> names;
+	for (const auto& entry : GetEntries())
+	{
+		names.push_back(entry.first);
+	}
+	return names;
+}
+
+const std::vector<std::string>& Tunables::GetNames()
+{
+	static const std::vector<std::string> names = MakeNames();
+	return names;
+}
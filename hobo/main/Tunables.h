@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_TUNABLES_H
+#define HOBO_MAIN_TUNABLES_H
+
+#include <string>
+#include <vector>
+
+/**
+ * The game balance constants, gathered in one place so that they can be
+ * changed at runtime by tools sweeping for a better balance. The game objects
+ * keep a reference to the tunables of their game, angles are in degrees.
+ */
+struct Tunables final
+{
+	Tunables();
+
+	/**
+	 * Returns the tunable with the given name, or NULL if there is none.
+	 */
+	float* Find(const std::string& name);
+
+	static const std::vector<std::string>& GetNames();
+
+	// Trigger
+	float m_boost30Angle;
+	float m_boost45Angle;
+	float m_boost60Angle;
+	float m_boostVel;
+	float m_comboBoostVel;
+	float m_comboHeadStraightVel;
+	float m_stopComboAngle;
+	float m_stopComboVel;
+	float m_playerSlowdownVelScale;
+
+	// Player
+	float m_groundHitVelScale;
+	float m_bounceBoost;
+	float m_soarDistanceFull;
+
+	// ComboController
+	float m_comboTimeToExecute;
+
+	// TriggerManager
+	float m_triggerDistance;
+};
+
+inline Tunables::Tunables()
+	: m_boost30Angle(30.0f)
+	, m_boost45Angle(45.0f)
+	, m_boost60Angle(60.0f)
+	, m_boostVel(11.0f)
+	, m_comboBoostVel(16.0f)
+	, m_comboHeadStraightVel(15.0f)
+	, m_stopComboAngle(45.0f)
+	, m_stopComboVel(22.0f)
+	, m_playerSlowdownVelScale(0.55f)
+	, m_groundHitVelScale(0.8f)
+	, m_bounceBoost(2.0f)
+	, m_soarDistanceFull(500.0f)
+	, m_comboTimeToExecute(700.0f)
+	, m_triggerDistance(10.0f)
+{
+}
+
+#endif // HOBO_MAIN_TUNABLES_H
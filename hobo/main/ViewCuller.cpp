@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "main/ViewCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "nanaka/entity/Entity.h"
+
+ViewCuller::ViewCuller()
+	: m_maxHalfWidth(0.0f)
+{
+}
+
+void ViewCuller::Add(
+	std::shared_ptr<Entity> entity,
+	AttachmentId gfxId,
+	float width,
+	float height)
+{
+	Entry entry;
+	entry.m_entity = entity;
+	entry.m_gfxId = gfxId;
+	entry.m_x = entity->GetPosition().x;
+	entry.m_halfWidth = width * 0.5f;
+	entry.m_halfHeight = height * 0.5f;
+	entry.m_visible = true;
+	m_entries.push_back(entry);
+
+	// The attachment may have been hidden while not culled here.
+	entity->GetModule<SceneEM>()->SetVisibility(gfxId, true);
+
+	m_maxHalfWidth = std::max(m_maxHalfWidth, entry.m_halfWidth);
+}
+
+void ViewCuller::Remove(const std::shared_ptr<Entity>& entity)
+{
+	m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+		[&](const Entry& entry) { return entry.m_entity == entity; }),
+		m_entries.end());
+}
+
+void ViewCuller::Cull(Vec3f viewPosition, Vec2f viewDimensions)
+{
+	// Entities move a little between frames, so the entries stay nearly
+	// sorted and an insertion sort is close to a single pass.
+	for (auto& entry : m_entries)
+	{
+		entry.m_x = entry.m_entity->GetPosition().x;
+	}
+	for (size_t i = 1; i < m_entries.size(); ++i)
+	{
+		for (size_t j = i; j > 0 && m_entries[j].m_x < m_entries[j - 1].m_x;
+			--j)
+		{
+			std::swap(m_entries[j], m_entries[j - 1]);
+		}
+	}
+
+	const float viewLeft = viewPosition.x - viewDimensions.x * 0.5f;
+	const float viewRight = viewPosition.x + viewDimensions.x * 0.5f;
+
+	// Nothing wider than the widest entry can reach into the view from
+	// outside this slice.
+	auto sliceBegin = std::lower_bound(
+		m_entries.begin(), m_entries.end(), viewLeft - m_maxHalfWidth,
+		[](const Entry& entry, float x) { return entry.m_x < x; });
+	auto sliceEnd = std::upper_bound(
+		sliceBegin, m_entries.end(), viewRight + m_maxHalfWidth,
+		[](float x, const Entry& entry) { return x < entry.m_x; });
+
+	for (auto it = m_entries.begin(); it != sliceBegin; ++it)
+	{
+		SetVisible(*it, false);
+	}
+
+	for (auto it = sliceBegin; it != sliceEnd; ++it)
+	{
+		const float z = it->m_entity->GetPosition().z;
+		const bool visible =
+			std::abs(it->m_x - viewPosition.x)
+				< viewDimensions.x * 0.5f + it->m_halfWidth
+			&& std::abs(z - viewPosition.z)
+				< viewDimensions.y * 0.5f + it->m_halfHeight;
+		SetVisible(*it, visible);
+	}
+
+	for (auto it = sliceEnd; it != m_entries.end(); ++it)
+	{
+		SetVisible(*it, false);
+	}
+}
+
+void ViewCuller::SetVisible(Entry& entry, bool visible)
+{
+	// Only touch the scene when the visibility actually changes.
+	if (entry.m_visible != visible)
+	{
+		entry.m_entity->GetModule<SceneEM>()->SetVisibility(
+			entry.m_gfxId, visible);
+		entry.m_visible = visible;
+	}
+}
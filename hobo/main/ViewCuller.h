@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOBO_MAIN_VIEWCULLER_H
+#define HOBO_MAIN_VIEWCULLER_H
+
+#include <memory>
+#include <vector>
+
+#include "nanaka/math/Vec2f.h"
+#include "nanaka/math/Vec3f.h"
+#include "nanaka/scene/SceneEM.h"
+
+class Entity;
+
+/**
+ * Hides attachments outside the camera view so that the scene does not draw
+ * them. The game is a side-scroller, so entries are kept sorted by x and only
+ * the slice around the view is tested against the view rectangle.
+ *
+ * Only attachments whose visibility is not otherwise controlled by the game
+ * should be added, like the billboards of the layers.
+ */
+class ViewCuller final
+{
+public:
+
+	ViewCuller();
+
+	/**
+	 * Width and height are the extents of the attachment in x and z.
+	 */
+	void Add(
+		std::shared_ptr<Entity> entity,
+		AttachmentId gfxId,
+		float width,
+		float height);
+	void Remove(const std::shared_ptr<Entity>& entity);
+
+	/**
+	 * Takes the view as presented, in x and z.
+	 */
+	void Cull(Vec3f viewPosition, Vec2f viewDimensions);
+
+private:
+
+	struct Entry
+	{
+		std::shared_ptr<Entity> m_entity;
+		AttachmentId m_gfxId;
+		float m_x;
+		float m_halfWidth;
+		float m_halfHeight;
+		bool m_visible;
+	};
+
+	void SetVisible(Entry& entry, bool visible);
+
+	std::vector<Entry> m_entries;
+	float m_maxHalfWidth;
+};
+
+#endif // HOBO_MAIN_VIEWCULLER_H
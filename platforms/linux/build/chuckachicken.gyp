@@ -1,4 +1,7 @@
 {
+  'variables': {
+    'hobo_bench%': 0,
+  },
   'targets': [
     {
       'target_name': 'chuckachicken',
@@ -10,6 +13,7 @@
       'include_dirs': [
         '<(DEPTH)/platforms/linux/src',
         '<(DEPTH)',
+        '<(DEPTH)/hobo',
         '<(DEPTH)/nanaka',
       ],
       'sources': [
@@ -20,12 +24,148 @@
         '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.h',
         '<(DEPTH)/platforms/linux/src/Application.cpp',
         '<(DEPTH)/platforms/linux/src/Application.h',
+        '<(DEPTH)/platforms/linux/src/InputSession.cpp',
+        '<(DEPTH)/platforms/linux/src/InputSession.h',
         '<(DEPTH)/platforms/linux/src/Main.cpp',
       ],
       'link_settings': {
         'libraries': [
           '-lglfw',
           '-lGLEW',
+          '-lpthread',
+        ],
+      },
+      'conditions': [
+        ['hobo_bench==1', {
+          'defines': [
+            'HOBO_BENCH',
+          ],
+          'sources': [
+            '<(DEPTH)/hobo/bench/AllocationCounter.cpp',
+            '<(DEPTH)/hobo/bench/AllocationCounter.h',
+          ],
+        }],
+      ],
+    },
+    {
+      'target_name': 'hobo_bench',
+      'type': 'executable',
+      'dependencies': [
+        '<(DEPTH)/nanaka/build/nanaka.gyp:nanaka',
+        '<(DEPTH)/hobo/build/hobo.gyp:hobo',
+      ],
+      'include_dirs': [
+        '<(DEPTH)',
+        '<(DEPTH)/hobo',
+        '<(DEPTH)/nanaka',
+      ],
+      'sources': [
+        '<(DEPTH)/hobo/bench/AllocationCounter.cpp',
+        '<(DEPTH)/hobo/bench/AllocationCounter.h',
+        '<(DEPTH)/hobo/bench/Benchmark.cpp',
+        '<(DEPTH)/hobo/bench/Benchmark.h',
+        '<(DEPTH)/hobo/bench/BenchMain.cpp',
+        '<(DEPTH)/hobo/bench/HeadlessApplication.h',
+        '<(DEPTH)/nanaka/pi/glfw/GLContextManagerImpl.cpp',
+        '<(DEPTH)/nanaka/pi/glfw/GLContextManagerImpl.h',
+        '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.cpp',
+        '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.h',
+      ],
+      'link_settings': {
+        'libraries': [
+          '-lglfw',
+          '-lGLEW',
+        ],
+      },
+    },
+    {
+      'target_name': 'hobo_determinism',
+      'type': 'executable',
+      'dependencies': [
+        '<(DEPTH)/nanaka/build/nanaka.gyp:nanaka',
+        '<(DEPTH)/hobo/build/hobo.gyp:hobo',
+      ],
+      'include_dirs': [
+        '<(DEPTH)',
+        '<(DEPTH)/hobo',
+        '<(DEPTH)/nanaka',
+      ],
+      'sources': [
+        '<(DEPTH)/hobo/bench/DeterminismMain.cpp',
+        '<(DEPTH)/hobo/bench/HeadlessApplication.h',
+        '<(DEPTH)/hobo/bench/Simulation.cpp',
+        '<(DEPTH)/hobo/bench/Simulation.h',
+        '<(DEPTH)/nanaka/pi/glfw/GLContextManagerImpl.cpp',
+        '<(DEPTH)/nanaka/pi/glfw/GLContextManagerImpl.h',
+        '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.cpp',
+        '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.h',
+      ],
+      'link_settings': {
+        'libraries': [
+          '-lglfw',
+          '-lGLEW',
+        ],
+      },
+    },
+    {
+      'target_name': 'hobo_autoplay',
+      'type': 'executable',
+      'dependencies': [
+        '<(DEPTH)/nanaka/build/nanaka.gyp:nanaka',
+        '<(DEPTH)/hobo/build/hobo.gyp:hobo',
+      ],
+      'include_dirs': [
+        '<(DEPTH)',
+        '<(DEPTH)/hobo',
+        '<(DEPTH)/nanaka',
+      ],
+      'sources': [
+        '<(DEPTH)/hobo/bench/AutoplayMain.cpp',
+        '<(DEPTH)/hobo/bench/Autoplayer.cpp',
+        '<(DEPTH)/hobo/bench/Autoplayer.h',
+        '<(DEPTH)/hobo/bench/HeadlessApplication.h',
+        '<(DEPTH)/hobo/bench/Simulation.cpp',
+        '<(DEPTH)/hobo/bench/Simulation.h',
+        '<(DEPTH)/nanaka/pi/glfw/GLContextManagerImpl.cpp',
+        '<(DEPTH)/nanaka/pi/glfw/GLContextManagerImpl.h',
+        '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.cpp',
+        '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.h',
+      ],
+      'link_settings': {
+        'libraries': [
+          '-lglfw',
+          '-lGLEW',
+          '-lpthread',
+        ],
+      },
+    },
+    {
+      'target_name': 'hobo_sweep',
+      'type': 'executable',
+      'dependencies': [
+        '<(DEPTH)/nanaka/build/nanaka.gyp:nanaka',
+        '<(DEPTH)/hobo/build/hobo.gyp:hobo',
+      ],
+      'include_dirs': [
+        '<(DEPTH)',
+        '<(DEPTH)/hobo',
+        '<(DEPTH)/nanaka',
+      ],
+      'sources': [
+        '<(DEPTH)/hobo/bench/HeadlessApplication.h',
+        '<(DEPTH)/hobo/bench/Simulation.cpp',
+        '<(DEPTH)/hobo/bench/Simulation.h',
+        '<(DEPTH)/hobo/bench/SweepMain.cpp',
+        '<(DEPTH)/nanaka/pi/glfw/GLContextManagerImpl.cpp',
+        '<(DEPTH)/nanaka/pi/glfw/GLContextManagerImpl.h',
+        '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.cpp',
+        '<(DEPTH)/nanaka/pi/posix/FileManagerImpl.h',
+      ],
+      'link_settings': {
+        'libraries': [
+          '-lglfw',
+          '-lGLEW',
+          '-lpthread',
         ],
       },
     },
@@ -25,11 +25,121 @@
 
 #include "Application.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
 #include "nanaka/pi/glfw/NanakaNativeWindowImpl.h"
 #include "nanaka/renderer/Renderer.h"
 
-LinuxApplication::LinuxApplication()
-	: m_nanaka(*this)
+#if defined(HOBO_BENCH)
+#include "bench/AllocationCounter.h"
+#endif // defined(HOBO_BENCH)
+#include "main/FrameStats.h"
+#include "main/Main.h"
+#include "main/RunSeeds.h"
+
+// Counting allocations replaces the global operator new, which only bench
+// builds link.
+#if defined(HOBO_BENCH)
+static size_t (*const s_allocationCounter)() = GetNumAllocations;
+#else
+static size_t (*const s_allocationCounter)() = NULL;
+#endif // defined(HOBO_BENCH)
+
+LinuxApplicationOptions::LinuxApplicationOptions()
+	: m_tolerance(0.1f)
+	, m_numRuns(1)
+{
+}
+
+bool LinuxApplicationOptions::Parse(int argc, char** argv)
+{
+	// Every option takes a value.
+	for (int i = 1; i < argc; i += 2)
+	{
+		if (i + 1 == argc)
+		{
+			printf("Missing value for %s.\n", argv[i]);
+			return false;
+		}
+
+		const char* value = argv[i + 1];
+		char* end = NULL;
+
+		if (strcmp(argv[i], "--record") == 0)
+		{
+			m_recordFilePath = value;
+		}
+		else if (strcmp(argv[i], "--replay") == 0)
+		{
+			m_replayFilePath = value;
+		}
+		else if (strcmp(argv[i], "--report") == 0)
+		{
+			m_reportFilePath = value;
+		}
+		else if (strcmp(argv[i], "--baseline") == 0)
+		{
+			m_baselineFilePath = value;
+		}
+		else if (strcmp(argv[i], "--tolerance") == 0)
+		{
+			m_tolerance = strtof(value, &end);
+			if (*end != '\0' || m_tolerance < 0.0f)
+			{
+				printf("Invalid tolerance %s.\n", value);
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--runs") == 0)
+		{
+			m_numRuns = strtoul(value, &end, 10);
+			if (*end != '\0' || m_numRuns == 0)
+			{
+				printf("Invalid number of runs %s.\n", value);
+				return false;
+			}
+		}
+		else
+		{
+			printf("Unknown option %s.\n", argv[i]);
+			return false;
+		}
+	}
+
+	if (!m_baselineFilePath.empty() && m_reportFilePath.empty())
+	{
+		printf("--baseline needs --report.\n");
+		return false;
+	}
+
+	// Every run would overwrite the session recorded by the one before.
+	if (!m_recordFilePath.empty() && m_numRuns > 1)
+	{
+		printf("--record cannot be used with --runs.\n");
+		return false;
+	}
+
+	return true;
+}
+
+void LinuxApplicationOptions::PrintUsage(const char* program)
+{
+	printf("Usage: %s [options]\n"
+		"  --record FILE     record pointer input and run seeds to FILE\n"
+		"  --replay FILE     replay a recorded session, then exit\n"
+		"  --report FILE     write a frame time report to FILE on exit\n"
+		"  --baseline FILE   fail if the report regressed from FILE\n"
+		"  --tolerance T     allowed regression, default 0.1\n"
+		"  --runs N          run the game N times in a row, default 1\n",
+		program);
+}
+
+LinuxApplication::LinuxApplication(const LinuxApplicationOptions& options)
+	: m_options(options)
+	, m_nanaka(*this)
 	, running(false)
 {
 }
@@ -38,6 +148,36 @@ int LinuxApplication::Run()
 {
 	running = true;
 
+	const bool replay = !m_options.m_replayFilePath.empty();
+	if (replay && !m_inputSession.Load(m_options.m_replayFilePath))
+	{
+		printf("Could not load %s.\n", m_options.m_replayFilePath.c_str());
+		return 1;
+	}
+
+	std::unique_ptr<FrameStats> frameStats;
+	if (!m_options.m_reportFilePath.empty())
+	{
+		frameStats = std::unique_ptr<FrameStats>(
+			new FrameStats(s_allocationCounter));
+	}
+
+	RunSeeds runSeeds;
+	if (replay)
+	{
+		runSeeds.Replay(m_inputSession.GetSeeds());
+	}
+
+	GameHost gameHost;
+	gameHost.m_frameStats = frameStats.get();
+	gameHost.m_frameGate = &m_frameGate;
+	gameHost.m_runSeeds = &runSeeds;
+	gameHost.m_recordHighscores = !replay;
+	SetGameHost(gameHost);
+
+	// Replays run the game a frame at a time, see the loop below.
+	m_frameGate.SetLockstep(replay);
+
 	m_nanaka.StartThread();
 	m_nanaka.OnResume();
 
@@ -69,6 +209,35 @@ int LinuxApplication::Run()
 	while (running)
 	{
 		glfwPollEvents();
+
+		if (replay)
+		{
+			// Feed the events of the coming frame and run it, waiting for it
+			// to end. Every replay sees the events on the same frames however
+			// fast the machine is.
+			const unsigned int frame = m_frameGate.GetNumFrames();
+			auto event = m_inputSession.NextDue(frame);
+			while (event)
+			{
+				m_nanaka.AddInputEvent(*event);
+				event = m_inputSession.NextDue(frame);
+			}
+
+			if (m_inputSession.IsFinished()
+				&& m_inputSession.GetLength() + s_replayTailFrames < frame)
+			{
+				running = false;
+				continue;
+			}
+
+			m_frameGate.RunFrame();
+
+#if defined(SINGLE_THREADED)
+			m_nanaka.ThreadLoop();
+#endif // defined(SINGLE_THREADED)
+			continue;
+		}
+
 		int mouse_state = glfwGetMouseButton(
 			&window.m_window, GLFW_MOUSE_BUTTON_LEFT);
 		double mouse_new_x = 0.0f, mouse_new_y = 0.0f;
@@ -104,11 +273,38 @@ int LinuxApplication::Run()
 #endif // defined(SINGLE_THREADED)
 	}
 
+	// Let a frame waiting to be run through before stopping the engine.
+	m_frameGate.SetLockstep(false);
 	m_nanaka.OnPause();
 	m_nanaka.KillThread();
 
+	SetGameHost(GameHost());
+
 	glfwTerminate();
-	return 0;
+
+	if (!m_options.m_recordFilePath.empty())
+	{
+		m_inputSession.SetSeeds(runSeeds.GetSeeds());
+		m_inputSession.Save(m_options.m_recordFilePath);
+	}
+
+	int ret = 0;
+
+	if (frameStats)
+	{
+		if (!frameStats->WriteReport(m_options.m_reportFilePath))
+		{
+			ret = 1;
+		}
+		else if (!m_options.m_baselineFilePath.empty()
+			&& !frameStats->CompareToBaseline(
+				m_options.m_baselineFilePath, m_options.m_tolerance))
+		{
+			ret = 1;
+		}
+	}
+
+	return ret;
 }
 
 void LinuxApplication::AddInputEvent(
@@ -123,4 +319,9 @@ void LinuxApplication::AddInputEvent(
 	event.m_pointerId = pointerId;
 
 	m_nanaka.AddInputEvent(event);
+
+	if (!m_options.m_recordFilePath.empty())
+	{
+		m_inputSession.Add(m_frameGate.GetNumFrames(), action, position);
+	}
 }
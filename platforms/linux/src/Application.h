@@ -26,16 +26,56 @@
 #ifndef LINUX_APPLICATION_H
 #define LINUX_APPLICATION_H
 
+#include <string>
+
 #include "nanaka/input/InputEvent.h"
 #include "nanaka/main/Nanaka.h"
 #include "nanaka/math/Vec2f.h"
 #include "nanaka/pi/Application.h"
 
+#include "main/FrameGate.h"
+
+#include "InputSession.h"
+
+struct LinuxApplicationOptions
+{
+	LinuxApplicationOptions();
+
+	/**
+	 * Returns false if any argument is not a known option followed by a
+	 * valid value.
+	 */
+	bool Parse(int argc, char** argv);
+
+	static void PrintUsage(const char* program);
+
+	/**
+	 * Records pointer input to the given file.
+	 */
+	std::string m_recordFilePath;
+
+	/**
+	 * Replays pointer input from the given file instead of reading the mouse,
+	 * and exits when the session is over.
+	 */
+	std::string m_replayFilePath;
+
+	/**
+	 * Writes a frame time report to the given file on exit, and compares it
+	 * against the baseline report if there is one.
+	 */
+	std::string m_reportFilePath;
+	std::string m_baselineFilePath;
+	float m_tolerance;
+
+	unsigned int m_numRuns;
+};
+
 class LinuxApplication final : public Application
 {
 public:
 
-	LinuxApplication();
+	LinuxApplication(const LinuxApplicationOptions& options);
 
 	int Run();
 
@@ -46,10 +86,17 @@ public:
 
 private:
 
+	static const unsigned int s_replayTailFrames = 120;
+
 	void AddInputEvent(Vec2f position, InputEventAction action, int pointerId);
 
+	LinuxApplicationOptions m_options;
+
 	Nanaka m_nanaka;
 	bool running;
+
+	InputSession m_inputSession;
+	FrameGate m_frameGate;
 };
 
 inline void LinuxApplication::Shutdown()
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "InputSession.h"
+
+#include <cstdio>
+
+InputSession::InputSession()
+	: m_nextEvent(0)
+{
+}
+
+bool InputSession::Load(const std::string& filePath)
+{
+	FILE* file = fopen(filePath.c_str(), "r");
+	if (!file)
+	{
+		return false;
+	}
+
+	m_events.clear();
+	m_nextEvent = 0;
+	m_seeds.clear();
+
+	char line[128];
+	while (fgets(line, sizeof(line), file))
+	{
+		unsigned int seed;
+		unsigned int frame;
+		int action;
+		float x, y;
+		if (sscanf(line, "seed %u", &seed) == 1)
+		{
+			m_seeds.push_back(seed);
+		}
+		else if (sscanf(line, "%u %d %f %f", &frame, &action, &x, &y) == 4)
+		{
+			Add(frame, static_cast<InputEventAction>(action), Vec2f(x, y));
+		}
+	}
+
+	fclose(file);
+	return true;
+}
+
+bool InputSession::Save(const std::string& filePath) const
+{
+	FILE* file = fopen(filePath.c_str(), "w");
+	if (!file)
+	{
+		return false;
+	}
+
+	for (unsigned int seed : m_seeds)
+	{
+		fprintf(file, "seed %u\n", seed);
+	}
+
+	for (const auto& recordedEvent : m_events)
+	{
+		fprintf(file, "%u %d %f %f\n",
+			recordedEvent.m_frame,
+			static_cast<int>(recordedEvent.m_event.m_action),
+			recordedEvent.m_event.m_position.x,
+			recordedEvent.m_event.m_position.y);
+	}
+
+	return fclose(file) == 0;
+}
+
+void InputSession::Add(
+	unsigned int frame,
+	InputEventAction action,
+	Vec2f position)
+{
+	RecordedEvent recordedEvent;
+	recordedEvent.m_frame = frame;
+	recordedEvent.m_event.m_type = MotionInputEventType;
+	recordedEvent.m_event.m_action = action;
+	recordedEvent.m_event.m_position = position;
+	recordedEvent.m_event.m_pointerId = 0;
+	m_events.push_back(recordedEvent);
+}
+
+const InputEvent* InputSession::NextDue(unsigned int frame)
+{
+	if (IsFinished() || m_events[m_nextEvent].m_frame > frame)
+	{
+		return NULL;
+	}
+
+	return &m_events[m_nextEvent++].m_event;
+}
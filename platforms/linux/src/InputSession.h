@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2013, Mathias Hällman. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINUX_INPUTSESSION_H
+#define LINUX_INPUTSESSION_H
+
+#include <string>
+#include <vector>
+
+#include "nanaka/input/InputEvent.h"
+#include "nanaka/math/Vec2f.h"
+
+/**
+ * Pointer input recorded with the number of game frames since the start of
+ * the session, along with the seed of each run, for replaying the same session
+ * later. Replays run the game in lockstep and feed each event on its frame.
+ */
+class InputSession final
+{
+public:
+
+	InputSession();
+
+	bool Load(const std::string& filePath);
+	bool Save(const std::string& filePath) const;
+
+	void Add(unsigned int frame, InputEventAction action, Vec2f position);
+
+	void SetSeeds(const std::vector<unsigned int>& seeds);
+	const std::vector<unsigned int>& GetSeeds() const;
+
+	/**
+	 * Returns the next event due at the given frame and moves past it, or
+	 * NULL if there is none.
+	 */
+	const InputEvent* NextDue(unsigned int frame);
+
+	bool IsFinished() const;
+	unsigned int GetLength() const;
+
+private:
+
+	struct RecordedEvent
+	{
+		unsigned int m_frame;
+		InputEvent m_event;
+	};
+
+	std::vector<RecordedEvent> m_events;
+	size_t m_nextEvent;
+
+	std::vector<unsigned int> m_seeds;
+};
+
+inline void InputSession::SetSeeds(const std::vector<unsigned int>& seeds)
+{
+	m_seeds = seeds;
+}
+
+inline const std::vector<unsigned int>& InputSession::GetSeeds() const
+{
+	return m_seeds;
+}
+
+inline bool InputSession::IsFinished() const
+{
+	return m_nextEvent >= m_events.size();
+}
+
+inline unsigned int InputSession::GetLength() const
+{
+	return m_events.empty() ? 0 : m_events.back().m_frame;
+}
+
+#endif // LINUX_INPUTSESSION_H
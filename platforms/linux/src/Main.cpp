@@ -27,11 +27,21 @@
 
 int main(int argc, char** argv)
 {
-	int runs = argc;
-	while (runs--)
+	LinuxApplicationOptions options;
+	if (!options.Parse(argc, argv))
 	{
-		auto app = std::make_shared<LinuxApplication>();
-		app->Run();
+		LinuxApplicationOptions::PrintUsage(argv[0]);
+		return 1;
+	}
+
+	for (unsigned int run = 0; run < options.m_numRuns; ++run)
+	{
+		auto app = std::make_shared<LinuxApplication>(options);
+		const int ret = app->Run();
+		if (ret != 0)
+		{
+			return ret;
+		}
 	}
 	return 0;
 }